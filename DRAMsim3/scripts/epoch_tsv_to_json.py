@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+"""
+Convert epoch stats written with epoch_format = tsv (dramsim3epoch.tsv) to the
+JSON array written with epoch_format = json (dramsim3epoch.json)
+"""
+
+import argparse
+import json
+import sys
+
+
+def tsv_to_records(tsv_file):
+    """
+    each channel's "#<channel>" row names its columns as <type>:<name>, where
+    uv/fv columns are element <index> of vector stat <name>.<index>
+
+    values are kept as text: doubles are already in the JSON serializer's
+    format, so they are copied as is instead of being re-printed
+    """
+    schemas = {}
+    for line in tsv_file:
+        fields = line.rstrip('\n').split('\t')
+        if fields[0].startswith('#'):
+            schemas[int(fields[0][1:])] = [f.split(':', 1) for f in fields[1:]]
+            continue
+        record = {}
+        for (col_type, name), text in zip(schemas[int(fields[0])], fields):
+            if col_type.endswith('v'):
+                name, idx = name.rsplit('.', 1)
+                record.setdefault(name, {})[idx] = text
+            else:
+                record[name] = text
+        yield record
+
+
+def dump_object(obj):
+    # same layout as nlohmann::json::dump(): sorted keys, no whitespace
+    items = []
+    for key in sorted(obj):
+        val = obj[key]
+        if isinstance(val, dict):
+            val = dump_object(val)
+        items.append(json.dumps(key) + ':' + val)
+    return '{' + ','.join(items) + '}'
+
+
+def dump_records(records, out):
+    out.write('[')
+    for i, record in enumerate(records):
+        if i > 0:
+            out.write(',\n')
+        out.write(dump_object(record))
+    out.write(']\n')
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Convert DRAMsim3 TSV epoch stats to the JSON format')
+    parser.add_argument('tsv', help='epoch stats file, e.g. dramsim3epoch.tsv')
+    parser.add_argument('-o', '--output', help='output file (default stdout)')
+    args = parser.parse_args()
+
+    with open(args.tsv, 'r') as tsv_file:
+        if args.output:
+            with open(args.output, 'w') as out:
+                dump_records(tsv_to_records(tsv_file), out)
+        else:
+            dump_records(tsv_to_records(tsv_file), sys.stdout)
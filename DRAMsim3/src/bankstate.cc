@@ -2,11 +2,10 @@
 
 namespace dramsim3 {
 
-BankState::BankState(const Config& config, SimpleStats& simple_stats, int rank, int bank_group, int bank)
+BankState::BankState(const Config& config, SimpleStats& simple_stats, int channel, int rank, int bank_group, int bank)
     :   config_(config),
         simple_stats_(simple_stats),
         state_(State::CLOSED),
-        cmd_timing_(static_cast<int>(CommandType::SIZE)),
         open_row_(-1),
         row_hit_count_(0),
         rank_(rank),
@@ -14,44 +13,33 @@ BankState::BankState(const Config& config, SimpleStats& simple_stats, int rank,
         bank_(bank),
         raa_ctr_(0),
         acts_counter_(0),
-        prac_(config_.rows, 0),
+        prac_(config_.rows),
         ref_idx_(0)
 {
-    cmd_timing_[static_cast<int>(CommandType::READ)] = 0;
-    cmd_timing_[static_cast<int>(CommandType::READ_PRECHARGE)] = 0;
-    cmd_timing_[static_cast<int>(CommandType::WRITE)] = 0;
-    cmd_timing_[static_cast<int>(CommandType::WRITE_PRECHARGE)] = 0;
-    cmd_timing_[static_cast<int>(CommandType::ACTIVATE)] = 0;
-    cmd_timing_[static_cast<int>(CommandType::PRECHARGE)] = 0;
-    cmd_timing_[static_cast<int>(CommandType::REFRESH_BANK)] = 0;
-    cmd_timing_[static_cast<int>(CommandType::REFsb)] = 0;
-    cmd_timing_[static_cast<int>(CommandType::REFab)] = 0;
-    cmd_timing_[static_cast<int>(CommandType::SREF_ENTER)] = 0;
-    cmd_timing_[static_cast<int>(CommandType::SREF_EXIT)] = 0;
-    cmd_timing_[static_cast<int>(CommandType::RFMsb)] = 0; // [RFM] Same Bank RFM
-    cmd_timing_[static_cast<int>(CommandType::RFMab)] = 0; // [RFM] All Bank RFM
-
     // [Stats]
     acts_stat_name_ = "acts." + std::to_string(rank_) + "." + std::to_string(bank_group_) + "." + std::to_string(bank_);    
-    simple_stats_.InitStat(acts_stat_name_, "counter", "ACTs Counter");
+    acts_stat_ = simple_stats_.InitStat(acts_stat_name_, "counter", "ACTs Counter");
+    if (config_.prac_enabled)
+        prac_per_trefi_stat_ = simple_stats_.GetVecCounterId("prac_per_tREFI");
 
     // [MIRZA]
     if (config_.mirza_mode == 1)
     {
         mirza_gct_.resize(config_.mirza_groups, 0);
         mirza_group_size = config_.rows / config_.mirza_groups;
+        mirza_rng_.seed(((channel * config_.ranks + rank) * config_.bankgroups + bank_group) * config_.banks_per_group + bank + 1);
 
         mirza_curr_gidx_ = 0;
         mirza_curr_gct_ = 0;
     }
     else if (config_.moat_mode == 1)
     {
-        moat_max_prac_idx_ = -1;
+        moat_q_ = MitigationQueue(config_.moat_qsize);
     }
 }
 
 
-Command BankState::GetReadyCommand(const Command& cmd, uint64_t clk) const {
+CommandType BankState::RequiredCommand(const Command& cmd) const {
     CommandType required_type = CommandType::SIZE;
     switch (state_) {
         case State::CLOSED:
@@ -145,17 +133,11 @@ Command BankState::GetReadyCommand(const Command& cmd, uint64_t clk) const {
             break;
     }
 
-    if (required_type != CommandType::SIZE)
-    {
-        if (clk >= cmd_timing_[static_cast<int>(required_type)])
-        {
-            return Command(required_type, cmd.addr, cmd.hex_addr);
-        }
-    }
-    return Command();
+    return required_type;
 }
 
 
+
 // 0, 1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, >= 1024
 uint32_t get_geostat_bin(uint16_t val)
 {
@@ -214,11 +196,14 @@ void BankState::UpdateState(const Command& cmd, uint64_t clk) {
                     acts_counter_ = 0;
 
                     // [PRAC]
-                    for (int i = 0; i < config_.rows_refreshed; i++)
+                    if (config_.prac_enabled)
                     {
-                        int idx = (ref_idx_ + i) % config_.rows;
-                        simple_stats_.IncrementVec("prac_per_tREFI", get_geostat_bin(prac_[idx]));
-                        prac_[idx] = 0;
+                        for (int i = 0; i < config_.rows_refreshed; i++)
+                        {
+                            int idx = (ref_idx_ + i) % config_.rows;
+                            simple_stats_.IncrementVec(prac_per_trefi_stat_, get_geostat_bin(prac_.Get(idx)));
+                            prac_.Reset(idx);
+                        }
                     }
 
                     // [MIRZA] Before updating ref_idx_
@@ -245,13 +230,13 @@ void BankState::UpdateState(const Command& cmd, uint64_t clk) {
 
                     // [Stats]
                     acts_counter_++;
-                    simple_stats_.Increment(acts_stat_name_);
+                    simple_stats_.Increment(acts_stat_);
 
                     // [RFM]
                     raa_ctr_++;
 
-                    // [PRAC]                    
-                    prac_[open_row_]++;
+                    // [PRAC]
+                    if (config_.prac_enabled) prac_.Increment(open_row_);
 
                     // [MIRZA]
                     mirza_act(open_row_);
@@ -302,12 +287,6 @@ void BankState::UpdateState(const Command& cmd, uint64_t clk) {
     return;
 }
 
-void BankState::UpdateTiming(CommandType cmd_type, uint64_t time) {
-    cmd_timing_[static_cast<int>(cmd_type)] =
-        std::max(cmd_timing_[static_cast<int>(cmd_type)], time);
-    return;
-}
-
 std::string BankState::StateToString(State state) const {
     switch (state) {
         case State::OPEN:
@@ -329,26 +308,17 @@ void BankState::PrintState() const {
     std::cout << "Open Row: " << open_row_ << std::endl;
     std::cout << "Row Hit Count: " << row_hit_count_ << std::endl;
     std::cout << "RAA Counter: " << raa_ctr_ << std::endl;
-
-    // Print the timing constraints
-    for (int i = 0; i < static_cast<int>(CommandType::SIZE); i++) {
-        std::cout << "Command: " << CommandTypeToString(static_cast<CommandType>(i)) << " Time: " << cmd_timing_[i] << std::endl;
-    }
 }
 
 bool BankState::CheckAlert()
 {
     if (config_.mirza_mode == 1)
     {
-        auto found = std::find_if(mirza_q_.begin(), mirza_q_.end(), [this] (const MIRZA_Q_Entry& entry) {
-            return entry.actctr >= config_.mirza_qth; // mirza_qth = 40
-        });
-        
-        if (found != mirza_q_.end())
+        if (!mirza_q_.Empty() and mirza_q_.Top().count >= static_cast<uint32_t>(config_.mirza_qth)) // mirza_qth = 40
         {
             return true;
         }
-        else if (mirza_q_.size() >= config_.mirza_qsize) // mirza_qsize = 4
+        else if (mirza_q_.Size() >= static_cast<size_t>(config_.mirza_qsize)) // mirza_qsize = 4
         {
             return true;
         }
@@ -359,7 +329,7 @@ bool BankState::CheckAlert()
     }
     else if (config_.moat_mode == 1)
     {
-        if (moat_max_prac_idx_ != -1 and prac_[moat_max_prac_idx_] > config_.moatth)
+        if (!moat_q_.Empty() and moat_q_.Top().count > static_cast<uint32_t>(config_.moatth))
         {
             return true;
         }
@@ -381,22 +351,12 @@ void BankState::mirza_act(uint32_t rowid)
 
     // [MIRZA]
     uint32_t group = rowid / mirza_group_size;
-    auto before = mirza_gct_[group]++;
-
-    // std::cout << acts_stat_name_ << "[mirza_act] rowid=" << rowid << " group=" << group << " mirza_gct_=" << mirza_gct_[group] << " before=" << before << " mirza_curr_gidx_=" << mirza_curr_gidx_ << " mirza_curr_gct_=" << mirza_curr_gct_ << std::endl;
-
-    // print mirza_gct_
-    // std::cout << "[mirza_act] mirza_gct_" << std::endl;
-    // for (auto& entry : mirza_gct_)
-    // {
-    //     std::cout << entry << " ";
-    // }
-    // std::cout << std::endl;
+    mirza_gct_[group]++;
 
     if (group == mirza_curr_gidx_)
     {
         mirza_curr_gct_++;
-        if (mirza_curr_gct_ <= config_.mirza_groupth)
+        if (mirza_curr_gct_ <= static_cast<uint32_t>(config_.mirza_groupth))
         {
             return;
         }
@@ -405,37 +365,18 @@ void BankState::mirza_act(uint32_t rowid)
     {
         return;
     }
-    
-    // if (!mirza_q_.empty())
-    // {
-    //     std::cout << "[mirza_act] mirza_q_" << std::endl;
-    //     for (auto& entry : mirza_q_)
-    //     {
-    //         std::cout << entry.to_string() << std::endl;
-    //     }
-    // }
-
-    auto found = std::find_if(mirza_q_.begin(), mirza_q_.end(), [rowid](const MIRZA_Q_Entry& entry) {
-        return entry.rowid == rowid;
-    });
 
-
-    if (found != mirza_q_.end())
+    if (mirza_q_.Contains(rowid))
     {
-        found->actctr++;
-        // std::cout << "[mirza_act] found rowid=" << rowid << " actctr=" << found->actctr << std::endl;
+        mirza_q_.Offer(rowid, mirza_q_.Count(rowid) + 1);
         return;
     }
 
     double targ_prob = 1.0 / config_.mirza_mintw;
-    double randval = static_cast<double>(rand() % (1 << 20)) / static_cast<double>(1 << 20);
+    double randval = static_cast<double>(mirza_rng_() % (1 << 20)) / static_cast<double>(1 << 20);
     if (randval < targ_prob)
     {
-        MIRZA_Q_Entry entry;
-        entry.rowid = rowid;
-        entry.groupid = group;
-        entry.actctr = 1;
-        mirza_q_.push_back(entry);
+        mirza_q_.Offer(rowid, 1);
     }
 }
 
@@ -453,49 +394,19 @@ void BankState::mirza_refresh()
     mirza_curr_gct_ = mirza_gct_[groupid];
     mirza_gct_[groupid] = 0;
 
-    // std::cout << acts_stat_name_ << "[mirza_refresh] ref_idx=" << ref_idx_ << " groupid=" << groupid << std::endl;
-
-    // if (!mirza_q_.empty())
-    // {
-    //     std::cout << "[mirza_refresh] before mirza_q_" << std::endl;
-    //     for (auto& entry : mirza_q_)
-    //     {
-    //         std::cout << entry.to_string() << std::endl;
-    //     }
-    // }
     // [Hrit] Not sure if we should do this?
-    mirza_q_.erase(std::remove_if(mirza_q_.begin(), mirza_q_.end(), [groupid] (const MIRZA_Q_Entry& entry) {
-        return entry.groupid == groupid;
-    }), mirza_q_.end());
-
-    // if (!mirza_q_.empty())
-    // {
-    //     std::cout << "[mirza_refresh] after mirza_q_" << std::endl;
-    //     for (auto& entry : mirza_q_)
-    //     {
-    //         std::cout << entry.to_string() << std::endl;
-    //     }
-    // }
+    mirza_q_.RemoveIf([this, groupid] (const MitigationQueue::Entry& entry) {
+        return entry.rowid / mirza_group_size == groupid;
+    });
 }
 
 void BankState::mirza_mitig()
 {
     if (config_.mirza_mode == 0) return;
 
-    // std::cout << acts_stat_name_ << "[mirza_mitig] mirza_q_" << std::endl;
-    // for (auto& entry : mirza_q_)
-    // {
-    //     std::cout << entry.to_string() << std::endl;
-    // }
-
-    auto max_entry = std::max_element(mirza_q_.begin(), mirza_q_.end(), [] (const MIRZA_Q_Entry& a, const MIRZA_Q_Entry& b) {
-        return a.actctr < b.actctr;
-    });
-
-    if (max_entry != mirza_q_.end())
+    if (!mirza_q_.Empty())
     {
-        // std::cout << "[mirza_mitig] max_entry rowid=" << max_entry->rowid << " actctr=" << max_entry->actctr << std::endl;
-        mirza_q_.erase(max_entry);
+        mirza_q_.Pop();
     }
 }
 
@@ -505,44 +416,42 @@ void BankState::moat_act(uint32_t rowid)
 {
     if (config_.moat_mode == 0) return;
 
-    if (moat_max_prac_idx_ == -1)
-    {
-        moat_max_prac_idx_ = rowid;
-    }
-    else if (prac_[rowid] > prac_[moat_max_prac_idx_])
-    {
-        moat_max_prac_idx_ = rowid;
-    }
+    moat_q_.Offer(rowid, prac_.Get(rowid));
 }
 
 void BankState::moat_refresh()
 {
     if (config_.moat_mode == 0) return;
 
-    // If the moat_max_prac_idx_ or moat_cur_mitig_idx_ is refresed, reset them
-    if ((moat_max_prac_idx_ >= ref_idx_) and (moat_max_prac_idx_ < (ref_idx_ + config_.rows_refreshed)))
-    {
-        moat_max_prac_idx_ = -1;
-    }
+    // Refreshed rows have their PRAC counters reset, so they stop being
+    // candidates (the refreshed rows may wrap past the last row)
+    moat_q_.RemoveIf([this] (const MitigationQueue::Entry& entry) {
+        return (entry.rowid + config_.rows - ref_idx_) % config_.rows <
+               static_cast<uint32_t>(config_.rows_refreshed);
+    });
 }
 
 void BankState::moat_mitig()
 {
     if (config_.moat_mode == 0) return;
 
-    if (moat_max_prac_idx_ == -1)
+    if (moat_q_.Empty())
     {
         return;
     }
 
-    prac_[moat_max_prac_idx_] = 0;
+    int rowid = moat_q_.Top().rowid;
+    moat_q_.Pop();
+    prac_.Reset(rowid);
     
-    if (moat_max_prac_idx_ > 0) prac_[moat_max_prac_idx_ - 1]++;
-    if (moat_max_prac_idx_ > 1) prac_[moat_max_prac_idx_ - 2]++;
-    if (moat_max_prac_idx_ < config_.rows - 1) prac_[moat_max_prac_idx_ + 1]++;
-    if (moat_max_prac_idx_ < config_.rows - 2) prac_[moat_max_prac_idx_ + 2]++;
-
-    moat_max_prac_idx_ = -1;
+    // Victim refreshes count as activations of the neighbours, which may now
+    // be the hottest rows
+    for (int neighbor : {rowid - 1, rowid - 2, rowid + 1, rowid + 2})
+    {
+        if (neighbor < 0 or neighbor >= config_.rows) continue;
+        prac_.Increment(neighbor);
+        moat_q_.Offer(neighbor, prac_.Get(neighbor));
+    }
 }
 
 }  // namespace dramsim3
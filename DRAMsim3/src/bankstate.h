@@ -1,38 +1,29 @@
 #ifndef __BANKSTATE_H
 #define __BANKSTATE_H
 
+#include <random>
 #include <vector>
 #include "common.h"
 #include "configuration.h"
+#include "mitigation_queue.h"
+#include "prac_counters.h"
 #include "simple_stats.h"
 
 namespace dramsim3 {
 
-// [MIRZA]
-struct MIRZA_Q_Entry {
-    uint32_t rowid;
-    uint16_t groupid;
-    uint16_t actctr;
-
-    std::string to_string() const
-    {
-        return "RowID: " + std::to_string(rowid) + " GroupID: " + std::to_string(groupid) + " ActCtr: " + std::to_string(actctr);
-    }
-};
-
 class BankState {
    public:
-    BankState(const Config& config, SimpleStats& simple_stats, int rank, int bank_group, int bank);
+    BankState(const Config& config, SimpleStats& simple_stats, int channel, int rank, int bank_group, int bank);
 
     enum class State { OPEN, CLOSED, SREF, PD, SIZE };
-    Command GetReadyCommand(const Command& cmd, uint64_t clk) const;
+
+    // Command the bank needs next to make progress on cmd, SIZE if none. The
+    // timing constraints live in ChannelState, which decides when it can issue
+    CommandType RequiredCommand(const Command& cmd) const;
 
     // Update the state of the bank resulting after the execution of the command
     void UpdateState(const Command& cmd, uint64_t clk);
 
-    // Update the existing timing constraints for the command
-    void UpdateTiming(const CommandType cmd_type, uint64_t time);
-
     bool IsRowOpen() const { return state_ == State::OPEN; }
     int OpenRow() const { return open_row_; }
     int RowHitCount() const { return row_hit_count_; }
@@ -50,9 +41,6 @@ class BankState {
     // Apriori or instantaneously transitions on a command.
     State state_;
 
-    // Earliest time when the particular Command can be executed in this bank
-    std::vector<uint64_t> cmd_timing_;
-
     // Currently open row
     int open_row_;
 
@@ -69,10 +57,12 @@ class BankState {
 
     // Activations
     std::string acts_stat_name_;
+    StatId acts_stat_;
+    StatId prac_per_trefi_stat_;
     int acts_counter_;
 
     // [PRAC] Counters
-    std::vector<uint16_t> prac_;
+    PRACCounters prac_;
 
     // [REF]
     uint32_t ref_idx_;
@@ -82,8 +72,10 @@ class BankState {
     void mirza_refresh();
     void mirza_mitig();
     std::vector<uint16_t> mirza_gct_;
-    std::vector<MIRZA_Q_Entry> mirza_q_;
+    MitigationQueue mirza_q_;
     uint32_t mirza_group_size;
+    // per-bank so channels can be ticked in parallel deterministically
+    std::minstd_rand mirza_rng_;
 
     // [MIRZA] Tracking the GCT of the current group being refreshed
     uint32_t mirza_curr_gidx_;
@@ -93,7 +85,7 @@ class BankState {
     void moat_act(uint32_t rowid);
     void moat_refresh();
     void moat_mitig();
-    int moat_max_prac_idx_;
+    MitigationQueue moat_q_;
 };
 
 }  // namespace dramsim3
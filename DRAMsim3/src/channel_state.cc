@@ -1,14 +1,19 @@
 #include "channel_state.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace dramsim3 {
-ChannelState::ChannelState(const Config& config, const Timing& timing, SimpleStats& simple_stats)
+ChannelState::ChannelState(int channel, const Config& config, const Timing& timing, SimpleStats& simple_stats)
     : rank_idle_cycles(config.ranks, 0),
       config_(config),
       timing_(timing),
       simple_stats_(simple_stats),
       rank_is_sref_(config.ranks, false),
       four_aw_(config_.ranks, std::vector<uint64_t>()),
-      thirty_two_aw_(config_.ranks, std::vector<uint64_t>()) {
+      thirty_two_aw_(config_.ranks, std::vector<uint64_t>()),
+      cmd_timing_(static_cast<int>(CommandType::SIZE),
+                  std::vector<uint64_t>(config_.ranks * config_.banks, 0)) {
     
     bank_states_.reserve(config_.ranks);
 
@@ -21,17 +26,18 @@ ChannelState::ChannelState(const Config& config, const Timing& timing, SimpleSta
             std::vector<BankState> bg_states;
             for (auto k = 0; k < config_.banks_per_group; k++)
             {
-                bg_states.push_back(BankState(config_, simple_stats_, i, j, k));
+                bg_states.push_back(BankState(config_, simple_stats_, channel, i, j, k));
             }
-            rank_states.push_back(bg_states);
+            rank_states.push_back(std::move(bg_states));
         }
-        bank_states_.push_back(rank_states);
+        bank_states_.push_back(std::move(rank_states));
     }
 
     // [ABO]
     alert_n = false;
     last_alert_clk_ = 0;
     num_acts_abo_ = 0;
+    num_alerts_stat_ = simple_stats_.GetCounterId("num_alerts");
 }
 
 void ChannelState::PrintDeadlock() const {
@@ -40,6 +46,12 @@ void ChannelState::PrintDeadlock() const {
             for (auto k = 0; k < config_.banks_per_group; k++) {
                 printf("Rank %d Bankgroup %d Bank %d\n", i, j, k);
                 bank_states_[i][j][k].PrintState();
+                for (int c = 0; c < static_cast<int>(CommandType::SIZE); c++) {
+                    std::cout << "Command: "
+                              << CommandTypeToString(static_cast<CommandType>(c))
+                              << " Time: " << cmd_timing_[c][BankIndex(i, j, k)]
+                              << std::endl;
+                }
                 printf("====================================\n");
             }
         }
@@ -175,6 +187,30 @@ void ChannelState::RankNeedRFM(int rank, bool need) {
     return;
 }
 
+Command ChannelState::BankReadyCommand(const Command& cmd, int rank,
+                                       int bankgroup, int bank,
+                                       uint64_t clk) const {
+    CommandType required_type =
+        bank_states_[rank][bankgroup][bank].RequiredCommand(cmd);
+    if (required_type != CommandType::SIZE &&
+        clk >= cmd_timing_[static_cast<int>(required_type)]
+                          [BankIndex(rank, bankgroup, bank)]) {
+        return Command(required_type, cmd.addr, cmd.hex_addr);
+    }
+    return Command();
+}
+
+uint64_t ChannelState::BankReadyTime(const Command& cmd) const {
+    CommandType required_type =
+        bank_states_[cmd.Rank()][cmd.Bankgroup()][cmd.Bank()].RequiredCommand(
+            cmd);
+    if (required_type == CommandType::SIZE) {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    return cmd_timing_[static_cast<int>(required_type)]
+                      [BankIndex(cmd.Rank(), cmd.Bankgroup(), cmd.Bank())];
+}
+
 Command ChannelState::GetReadyCommand(const Command& cmd, uint64_t clk) const
 {
     Command ready_cmd = Command();
@@ -182,7 +218,7 @@ Command ChannelState::GetReadyCommand(const Command& cmd, uint64_t clk) const
         int num_ready = 0;
         for (auto j = 0; j < config_.bankgroups; j++) {
             for (auto k = 0; k < config_.banks_per_group; k++) {
-                ready_cmd = bank_states_[cmd.Rank()][j][k].GetReadyCommand(cmd, clk);
+                ready_cmd = BankReadyCommand(cmd, cmd.Rank(), j, k, clk);
                 if (!ready_cmd.IsValid()) {  // Not ready
                     continue;
                 }
@@ -206,7 +242,7 @@ Command ChannelState::GetReadyCommand(const Command& cmd, uint64_t clk) const
     {
         int num_ready = 0;
         for (auto j = 0; j < config_.bankgroups; j++) {
-            ready_cmd = bank_states_[cmd.Rank()][j][cmd.Bank()].GetReadyCommand(cmd, clk);
+            ready_cmd = BankReadyCommand(cmd, cmd.Rank(), j, cmd.Bank(), clk);
             if (!ready_cmd.IsValid()) {  // Not ready
                 continue;
             }
@@ -227,8 +263,8 @@ Command ChannelState::GetReadyCommand(const Command& cmd, uint64_t clk) const
     } 
     else
     {
-        ready_cmd = bank_states_[cmd.Rank()][cmd.Bankgroup()][cmd.Bank()]
-                        .GetReadyCommand(cmd, clk);
+        ready_cmd = BankReadyCommand(cmd, cmd.Rank(), cmd.Bankgroup(),
+                                     cmd.Bank(), clk);
         
         if (!ready_cmd.IsValid()) {
             return Command();
@@ -333,7 +369,7 @@ void ChannelState::TriggerSameBankAlert(const Command& cmd, uint64_t clk)
     {
         alert_n = true;
         last_alert_clk_ = clk;
-        simple_stats_.Increment("num_alerts");
+        simple_stats_.Increment(num_alerts_stat_);
         // std::cout << "last_alert_clk_[" << cmd.Channel() << "]["<< cmd.Rank() << "][" << cmd.Bankgroup() << "][" << cmd.Bank() << "]: " << last_alert_clk_ << std::endl;
     }
     return;
@@ -360,7 +396,7 @@ void ChannelState::TriggerSameRankAlert(const Command& cmd, uint64_t clk)
             {
                 alert_n = true;
                 last_alert_clk_ = clk;
-                simple_stats_.Increment("num_alerts");
+                simple_stats_.Increment(num_alerts_stat_);
                 // std::cout << "last_alert_clk_[" << cmd.Rank() << "][" << cmd.Bankgroup() << "][" << cmd.Bank() << "]: " << last_alert_clk_ << std::endl;
             }
         }
@@ -381,30 +417,7 @@ void ChannelState::UpdateTiming(const Command& cmd, uint64_t clk)
         case CommandType::READ:
         case CommandType::WRITE:
         case CommandType::REFRESH_BANK:
-            // TODO - simulator speed? - Speciazlize which of the below
-            // functions to call depending on the command type  Same Bank
-            UpdateSameBankTiming(
-                cmd.addr, timing_.same_bank[static_cast<int>(cmd.cmd_type)],
-                clk);
-
-            // Same Bankgroup other banks
-            UpdateOtherBanksSameBankgroupTiming(
-                cmd.addr,
-                timing_
-                    .other_banks_same_bankgroup[static_cast<int>(cmd.cmd_type)],
-                clk);
-
-            // Other bankgroups
-            UpdateOtherBankgroupsSameRankTiming(
-                cmd.addr,
-                timing_
-                    .other_bankgroups_same_rank[static_cast<int>(cmd.cmd_type)],
-                clk);
-
-            // Other ranks
-            UpdateOtherRanksTiming(
-                cmd.addr, timing_.other_ranks[static_cast<int>(cmd.cmd_type)],
-                clk);
+            UpdateBankTiming(cmd.addr, cmd.cmd_type, clk);
             break;
 
         case CommandType::RFMab: // [RFM] All Bank RFM
@@ -420,13 +433,7 @@ void ChannelState::UpdateTiming(const Command& cmd, uint64_t clk)
         case CommandType::REFsb: // [RFM] Same Bank RFM
         case CommandType::RFMsb: // [RFM] Same Bank RFM
             TriggerSameRankAlert(cmd, clk);
-            UpdateSameBankset(
-                cmd.addr, timing_.same_bankset[static_cast<int>(cmd.cmd_type)],
-                clk);
-            
-            UpdateOtherBanksets(
-                cmd.addr, timing_.other_banksets[static_cast<int>(cmd.cmd_type)],
-                clk);
+            UpdateBanksetTiming(cmd.addr, cmd.cmd_type, clk);
             break;
         default:
             AbruptExit(__FILE__, __LINE__);
@@ -434,112 +441,71 @@ void ChannelState::UpdateTiming(const Command& cmd, uint64_t clk)
     return;
 }
 
-void ChannelState::UpdateSameBankset(
-    const Address& addr,
-    const std::vector<std::pair<CommandType, int>>& cmd_timing_list,
-    uint64_t clk) {
-    for (auto j = 0; j < config_.bankgroups; j++) {
-        for (auto cmd_timing : cmd_timing_list) {
-            bank_states_[addr.rank][j][addr.bank].UpdateTiming(
-                cmd_timing.first, clk + cmd_timing.second);
+void ChannelState::UpdateBankRange(const TimingList& cmd_timing_list,
+                                   int first, int last, uint64_t clk) {
+    for (const auto& cmd_timing : cmd_timing_list) {
+        uint64_t time = clk + cmd_timing.second;
+        uint64_t* bank_timing =
+            cmd_timing_[static_cast<int>(cmd_timing.first)].data();
+        for (int i = first; i < last; i++) {
+            bank_timing[i] = std::max(bank_timing[i], time);
         }
     }
     return;
 }
 
-void ChannelState::UpdateOtherBanksets(
-    const Address& addr,
-    const std::vector<std::pair<CommandType, int>>& cmd_timing_list,
-    uint64_t clk) {
-    for (auto i = 0; i < config_.ranks; i++) {
-        for (auto j = 0; j < config_.bankgroups; j++) {
-            for (auto k = 0; k < config_.banks_per_group; k++) {
-                if (k == addr.bank)
-                {
-                    continue;
-                }
-                for (auto cmd_timing : cmd_timing_list) {
-                    bank_states_[i][j][k].UpdateTiming(
-                        cmd_timing.first, clk + cmd_timing.second);
-                }
-            }
-        }
-    }
-    return;
-}
-
-void ChannelState::UpdateSameBankTiming(
-    const Address& addr,
-    const std::vector<std::pair<CommandType, int>>& cmd_timing_list,
-    uint64_t clk) {
-    for (auto cmd_timing : cmd_timing_list) {
-        bank_states_[addr.rank][addr.bankgroup][addr.bank].UpdateTiming(
-            cmd_timing.first, clk + cmd_timing.second);
-    }
+void ChannelState::UpdateBankTiming(const Address& addr, CommandType cmd_type,
+                                    uint64_t clk) {
+    int type = static_cast<int>(cmd_type);
+    int bank = BankIndex(addr.rank, addr.bankgroup, addr.bank);
+    int bankgroup_first = BankIndex(addr.rank, addr.bankgroup, 0);
+    int bankgroup_last = bankgroup_first + config_.banks_per_group;
+    int rank_first = BankIndex(addr.rank, 0, 0);
+    int rank_last = rank_first + config_.banks;
+
+    UpdateBankRange(timing_.same_bank[type], bank, bank + 1, clk);
+
+    const auto& same_bankgroup = timing_.other_banks_same_bankgroup[type];
+    UpdateBankRange(same_bankgroup, bankgroup_first, bank, clk);
+    UpdateBankRange(same_bankgroup, bank + 1, bankgroup_last, clk);
+
+    const auto& same_rank = timing_.other_bankgroups_same_rank[type];
+    UpdateBankRange(same_rank, rank_first, bankgroup_first, clk);
+    UpdateBankRange(same_rank, bankgroup_last, rank_last, clk);
+
+    const auto& other_ranks = timing_.other_ranks[type];
+    UpdateBankRange(other_ranks, 0, rank_first, clk);
+    UpdateBankRange(other_ranks, rank_last, config_.ranks * config_.banks,
+                    clk);
     return;
 }
 
-void ChannelState::UpdateOtherBanksSameBankgroupTiming(
-    const Address& addr,
-    const std::vector<std::pair<CommandType, int>>& cmd_timing_list,
-    uint64_t clk) {
-    for (auto k = 0; k < config_.banks_per_group; k++) {
-        if (k != addr.bank) {
-            for (auto cmd_timing : cmd_timing_list) {
-                bank_states_[addr.rank][addr.bankgroup][k].UpdateTiming(
-                    cmd_timing.first, clk + cmd_timing.second);
-            }
-        }
-    }
+void ChannelState::UpdateSameRankTiming(const Address& addr,
+                                        const TimingList& cmd_timing_list,
+                                        uint64_t clk) {
+    int rank_first = BankIndex(addr.rank, 0, 0);
+    UpdateBankRange(cmd_timing_list, rank_first, rank_first + config_.banks,
+                    clk);
     return;
 }
 
-void ChannelState::UpdateOtherBankgroupsSameRankTiming(
-    const Address& addr,
-    const std::vector<std::pair<CommandType, int>>& cmd_timing_list,
-    uint64_t clk) {
+void ChannelState::UpdateBanksetTiming(const Address& addr,
+                                       CommandType cmd_type, uint64_t clk) {
+    int type = static_cast<int>(cmd_type);
     for (auto j = 0; j < config_.bankgroups; j++) {
-        if (j != addr.bankgroup) {
-            for (auto k = 0; k < config_.banks_per_group; k++) {
-                for (auto cmd_timing : cmd_timing_list) {
-                    bank_states_[addr.rank][j][k].UpdateTiming(
-                        cmd_timing.first, clk + cmd_timing.second);
-                }
-            }
-        }
+        int bank = BankIndex(addr.rank, j, addr.bank);
+        UpdateBankRange(timing_.same_bankset[type], bank, bank + 1, clk);
     }
-    return;
-}
 
-void ChannelState::UpdateOtherRanksTiming(
-    const Address& addr,
-    const std::vector<std::pair<CommandType, int>>& cmd_timing_list,
-    uint64_t clk) {
+    // every bankgroup of every rank, around the bank of the bankset
     for (auto i = 0; i < config_.ranks; i++) {
-        if (i != addr.rank) {
-            for (auto j = 0; j < config_.bankgroups; j++) {
-                for (auto k = 0; k < config_.banks_per_group; k++) {
-                    for (auto cmd_timing : cmd_timing_list) {
-                        bank_states_[i][j][k].UpdateTiming(
-                            cmd_timing.first, clk + cmd_timing.second);
-                    }
-                }
-            }
-        }
-    }
-    return;
-}
-
-void ChannelState::UpdateSameRankTiming(
-    const Address& addr,
-    const std::vector<std::pair<CommandType, int>>& cmd_timing_list,
-    uint64_t clk) {
-    for (auto j = 0; j < config_.bankgroups; j++) {
-        for (auto k = 0; k < config_.banks_per_group; k++) {
-            for (auto cmd_timing : cmd_timing_list) {
-                bank_states_[addr.rank][j][k].UpdateTiming(
-                    cmd_timing.first, clk + cmd_timing.second);
-            }
+        for (auto j = 0; j < config_.bankgroups; j++) {
+            int bankgroup_first = BankIndex(i, j, 0);
+            int bank = bankgroup_first + addr.bank;
+            UpdateBankRange(timing_.other_banksets[type], bankgroup_first,
+                            bank, clk);
+            UpdateBankRange(timing_.other_banksets[type], bank + 1,
+                            bankgroup_first + config_.banks_per_group, clk);
         }
     }
     return;
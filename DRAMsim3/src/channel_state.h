@@ -1,6 +1,7 @@
 #ifndef __CHANNEL_STATE_H
 #define __CHANNEL_STATE_H
 
+#include <utility>
 #include <vector>
 #include "bankstate.h"
 #include "common.h"
@@ -13,8 +14,10 @@ namespace dramsim3 {
 
 class ChannelState {
    public:
-    ChannelState(const Config& config, const Timing& timing, SimpleStats& simple_stats);
+    ChannelState(int channel, const Config& config, const Timing& timing, SimpleStats& simple_stats);
     Command GetReadyCommand(const Command& cmd, uint64_t clk) const;
+    // lower bound on when GetReadyCommand can succeed for a bank command
+    uint64_t BankReadyTime(const Command& cmd) const;
     void UpdateState(const Command& cmd, uint64_t clk);
     void UpdateTiming(const Command& cmd, uint64_t clk);
     void UpdateTimingAndStates(const Command& cmd, uint64_t clk);
@@ -67,51 +70,47 @@ class ChannelState {
 
     bool alert_n;
     uint64_t last_alert_clk_;
+    StatId num_alerts_stat_;
     int num_acts_abo_;
     void TriggerSameBankAlert(const Command& cmd, uint64_t clk);
     void TriggerSameRankAlert(const Command& cmd, uint64_t clk);
     void ResetAlert() { alert_n = false; }
 
-    void UpdateSameBankset(
-        const Address& addr,
-        const std::vector<std::pair<CommandType, int> >& cmd_timing_list,
-        uint64_t clk);
-    
-    void UpdateOtherBanksets(
-        const Address& addr,
-        const std::vector<std::pair<CommandType, int> >& cmd_timing_list,
-        uint64_t clk);
-
-    // Update timing of the bank the command corresponds to    
-    void UpdateSameBankTiming(
-        const Address& addr,
-        const std::vector<std::pair<CommandType, int> >& cmd_timing_list,
-        uint64_t clk);
-
-    // Update timing of the other banks in the same bankgroup as the command
-    void UpdateOtherBanksSameBankgroupTiming(
-        const Address& addr,
-        const std::vector<std::pair<CommandType, int> >& cmd_timing_list,
-        uint64_t clk);
-
-    // Update timing of banks in the same rank but different bankgroup as the
-    // command
-    void UpdateOtherBankgroupsSameRankTiming(
-        const Address& addr,
-        const std::vector<std::pair<CommandType, int> >& cmd_timing_list,
-        uint64_t clk);
-
-    // Update timing of banks in a different rank as the command
-    void UpdateOtherRanksTiming(
-        const Address& addr,
-        const std::vector<std::pair<CommandType, int> >& cmd_timing_list,
-        uint64_t clk);
+    using TimingList = std::vector<std::pair<CommandType, int> >;
+
+    // Earliest time each command can be issued to each bank, laid out as one
+    // contiguous array of banks per CommandType (structure of arrays). Banks
+    // are indexed by BankIndex, so a rank, a bankgroup, or everything outside
+    // of one is a single range or two, and updates are plain max loops
+    std::vector<std::vector<uint64_t> > cmd_timing_;
+
+    int BankIndex(int rank, int bankgroup, int bank) const {
+        return (rank * config_.bankgroups + bankgroup) *
+                   config_.banks_per_group +
+               bank;
+    }
+
+    // required command for cmd if its timing is met at clk, else invalid
+    Command BankReadyCommand(const Command& cmd, int rank, int bankgroup,
+                             int bank, uint64_t clk) const;
+
+    // raise the timing of banks [first, last) by the constraints in the list
+    void UpdateBankRange(const TimingList& cmd_timing_list, int first,
+                         int last, uint64_t clk);
+
+    // Update timing of the bank the command corresponds to, the other banks
+    // of its bankgroup, the other bankgroups of its rank and the other ranks
+    void UpdateBankTiming(const Address& addr, CommandType cmd_type,
+                          uint64_t clk);
 
     // Update timing of the entire rank (for rank level commands)
-    void UpdateSameRankTiming(
-        const Address& addr,
-        const std::vector<std::pair<CommandType, int> >& cmd_timing_list,
-        uint64_t clk);
+    void UpdateSameRankTiming(const Address& addr,
+                              const TimingList& cmd_timing_list, uint64_t clk);
+
+    // Update timing of the same bank in every bankgroup (same bank commands)
+    // and of all the other banks in the channel
+    void UpdateBanksetTiming(const Address& addr, CommandType cmd_type,
+                             uint64_t clk);
 };
 
 }  // namespace dramsim3
@@ -1,4 +1,6 @@
 #include "command_queue.h"
+#include <algorithm>
+#include <limits>
 
 namespace dramsim3 {
 
@@ -9,6 +11,7 @@ CommandQueue::CommandQueue(int channel_id, const Config& config,
       config_(config),
       channel_state_(channel_state),
       simple_stats_(simple_stats),
+      num_ondemand_pres_stat_(simple_stats.GetCounterId("num_ondemand_pres")),
       is_in_ref_(false),
       is_in_rfm_(false),
       queue_size_(static_cast<size_t>(config_.cmd_queue_size)),
@@ -32,25 +35,28 @@ CommandQueue::CommandQueue(int channel_id, const Config& config,
         cmd_queue.reserve(config_.cmd_queue_size);
         queues_.push_back(cmd_queue);
     }
+    ready_clk_.resize(num_queues_, std::numeric_limits<uint64_t>::max());
+    ref_q_indices_.resize(num_queues_, false);
+    rfm_q_indices_.resize(num_queues_, false);
 }
 
 Command CommandQueue::GetCommandToIssue() {
     for (int i = 0; i < num_queues_; i++) {
         auto& queue = GetNextQueue();
         // if we're refresing, skip the command queues that are involved
-        if (is_in_ref_) {
-            if (ref_q_indices_.find(queue_idx_) != ref_q_indices_.end()) {
-                continue;
-            }
+        if (is_in_ref_ && ref_q_indices_[queue_idx_]) {
+            continue;
         }
 
-        if (is_in_rfm_) {
-            if (rfm_q_indices_.find(queue_idx_) != rfm_q_indices_.end()) {
-                continue;
-            }
+        if (is_in_rfm_ && rfm_q_indices_[queue_idx_]) {
+            continue;
+        }
+
+        if (clk_ < ready_clk_[queue_idx_]) {
+            continue;
         }
 
-        auto cmd = GetFirstReadyInQueue(queue);
+        auto cmd = GetFirstReadyInQueue(queue, ready_clk_[queue_idx_]);
         if (cmd.IsValid()) {
             if (cmd.IsReadWrite()) {
                 EraseRWCommand(cmd);
@@ -79,7 +85,7 @@ Command CommandQueue::FinishRefresh() {
     auto cmd = channel_state_.GetReadyCommand(ref, clk_);
 
     if (cmd.IsRefresh()) {
-        ref_q_indices_.clear();
+        std::fill(ref_q_indices_.begin(), ref_q_indices_.end(), false);
         is_in_ref_ = false;
     }
     return cmd;
@@ -98,7 +104,7 @@ Command CommandQueue::FinishRFM() {
     auto cmd = channel_state_.GetReadyCommand(rfm, clk_);
 
     if (cmd.IsRFM()) {
-        rfm_q_indices_.clear();
+        std::fill(rfm_q_indices_.begin(), rfm_q_indices_.end(), false);
         is_in_rfm_ = false;
     }
     return cmd;
@@ -133,7 +139,7 @@ bool CommandQueue::ArbitratePrecharge(const CMDIterator& cmd_it,
         channel_state_.RowHitCount(cmd.Rank(), cmd.Bankgroup(), cmd.Bank()) >=
         4;
     if (!pending_row_hits_exist || rowhit_limit_reached) {
-        simple_stats_.Increment("num_ondemand_pres");
+        simple_stats_.Increment(num_ondemand_pres_stat_);
         return true;
     }
     return false;
@@ -159,6 +165,9 @@ bool CommandQueue::AddCommand(Command cmd) {
     if (queue.size() < queue_size_) {
         queue.push_back(cmd);
         rank_q_empty[cmd.Rank()] = false;
+        int q_idx = GetQueueIndex(cmd.Rank(), cmd.Bankgroup(), cmd.Bank());
+        ready_clk_[q_idx] =
+            std::min(ready_clk_[q_idx], channel_state_.BankReadyTime(cmd));
         return true;
     } else {
         return false;
@@ -178,24 +187,24 @@ void CommandQueue::GetRefQIndices(const Command& ref) {
         if (queue_structure_ == QueueStructure::PER_BANK) {
             for (int i = 0; i < num_queues_; i++) {
                 if (i / config_.banks == ref.Rank()) {
-                    ref_q_indices_.insert(i);
+                    ref_q_indices_[i] = true;
                 }
             }
         } else {
-            ref_q_indices_.insert(ref.Rank());
+            ref_q_indices_[ref.Rank()] = true;
         }
     } else if (ref.cmd_type == CommandType::REFsb) {
         if (queue_structure_ == QueueStructure::PER_BANK) {
             for (int i = 0; i < config_.bankgroups; i++) {
                 int idx = GetQueueIndex(ref.Rank(), i, ref.Bank());
-                ref_q_indices_.insert(idx);
+                ref_q_indices_[idx] = true;
             }
         } else {
             throw std::runtime_error("Cannot have per rank queue structure for REFsb");
         }
     } else {  // refb
         int idx = GetQueueIndex(ref.Rank(), ref.Bankgroup(), ref.Bank());
-        ref_q_indices_.insert(idx);
+        ref_q_indices_[idx] = true;
     }
     return;
 }
@@ -205,20 +214,20 @@ void CommandQueue::GetRFMQIndices(const Command& rfm) {
         if (queue_structure_ == QueueStructure::PER_BANK) {
             for (int i = 0; i < num_queues_; i++) {
                 if (i / config_.banks == rfm.Rank()) {
-                    rfm_q_indices_.insert(i);
+                    rfm_q_indices_[i] = true;
                 }
             }
         } else {
-            rfm_q_indices_.insert(rfm.Rank());
+            rfm_q_indices_[rfm.Rank()] = true;
         }
     } else {  // RFMSB: [TODO]
         if (queue_structure_ == QueueStructure::PER_BANK) {
             for (int i = 0; i < config_.bankgroups; i++) {
                 int idx = GetQueueIndex(rfm.Rank(), i, rfm.Bank());
-                rfm_q_indices_.insert(idx);
+                rfm_q_indices_[idx] = true;
             }
         } else {
-            rfm_q_indices_.insert(rfm.Rank());
+            rfm_q_indices_[rfm.Rank()] = true;
         }
     }
     return;
@@ -238,8 +247,17 @@ CMDQueue& CommandQueue::GetQueue(int rank, int bankgroup, int bank) {
     return queues_[index];
 }
 
-Command CommandQueue::GetFirstReadyInQueue(CMDQueue& queue) const {
+Command CommandQueue::GetFirstReadyInQueue(CMDQueue& queue,
+                                           uint64_t& ready_clk) const {
+    ready_clk = std::numeric_limits<uint64_t>::max();
     for (auto cmd_it = queue.begin(); cmd_it != queue.end(); cmd_it++) {
+        // commands whose bank isn't ready yet can be skipped without asking
+        // the channel state, which may queue RFMs as a side effect
+        uint64_t cmd_ready_clk = channel_state_.BankReadyTime(*cmd_it);
+        ready_clk = std::min(ready_clk, cmd_ready_clk);
+        if (clk_ < cmd_ready_clk) {
+            continue;
+        }
         Command cmd = channel_state_.GetReadyCommand(*cmd_it, clk_);
         if (!cmd.IsValid()) {
             continue;
@@ -258,6 +276,21 @@ Command CommandQueue::GetFirstReadyInQueue(CMDQueue& queue) const {
     return Command();
 }
 
+void CommandQueue::InvalidateReadyTimes(const Command& cmd) {
+    if (queue_structure_ == QueueStructure::PER_RANK) {
+        ready_clk_[cmd.Rank()] = 0;
+    } else if (cmd.IsRankCMD()) {
+        std::fill(ready_clk_.begin() + cmd.Rank() * config_.banks,
+                  ready_clk_.begin() + (cmd.Rank() + 1) * config_.banks, 0);
+    } else if (cmd.IsSbCMD()) {
+        for (int i = 0; i < config_.bankgroups; i++) {
+            ready_clk_[GetQueueIndex(cmd.Rank(), i, cmd.Bank())] = 0;
+        }
+    } else {
+        ready_clk_[GetQueueIndex(cmd.Rank(), cmd.Bankgroup(), cmd.Bank())] = 0;
+    }
+}
+
 void CommandQueue::EraseRWCommand(const Command& cmd) {
     auto& queue = GetQueue(cmd.Rank(), cmd.Bankgroup(), cmd.Bank());
     for (auto cmd_it = queue.begin(); cmd_it != queue.end(); cmd_it++) {
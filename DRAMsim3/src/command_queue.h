@@ -1,7 +1,6 @@
 #ifndef __COMMAND_QUEUE_H
 #define __COMMAND_QUEUE_H
 
-#include <unordered_set>
 #include <vector>
 #include <cassert>
 #include "channel_state.h"
@@ -27,6 +26,8 @@ class CommandQueue {
     bool AddCommand(Command cmd);
     bool QueueEmpty() const;
     int QueueUsage() const;
+    // cmd changed bank state, so cached ready times of its queues are stale
+    void InvalidateReadyTimes(const Command& cmd);
     std::vector<bool> rank_q_empty;
 
    private:
@@ -34,7 +35,7 @@ class CommandQueue {
                             const CMDQueue& queue) const;
     bool HasRWDependency(const CMDIterator& cmd_it,
                          const CMDQueue& queue) const;
-    Command GetFirstReadyInQueue(CMDQueue& queue) const;
+    Command GetFirstReadyInQueue(CMDQueue& queue, uint64_t& ready_clk) const;
     int GetQueueIndex(int rank, int bankgroup, int bank) const;
     CMDQueue& GetQueue(int rank, int bankgroup, int bank);
     CMDQueue& GetNextQueue();
@@ -47,15 +48,21 @@ class CommandQueue {
     const Config& config_;
     const ChannelState& channel_state_;
     SimpleStats& simple_stats_;
+    StatId num_ondemand_pres_stat_;
 
     std::vector<CMDQueue> queues_;
 
-    // Refresh related data structures
-    std::unordered_set<int> ref_q_indices_;
+    // Per queue, no command in it can be issued before this cycle (a lower
+    // bound from bank timing). Timing updates only push the real value later,
+    // so it is reset only when a command is added or its bank changes state
+    std::vector<uint64_t> ready_clk_;
+
+    // Refresh related data structures (queues blocked by the pending refresh)
+    std::vector<bool> ref_q_indices_;
     bool is_in_ref_;
 
     // [RFM] related data structures
-    std::unordered_set<int> rfm_q_indices_;
+    std::vector<bool> rfm_q_indices_;
     bool is_in_rfm_;
 
     int num_queues_;
@@ -129,10 +129,12 @@ struct Transaction {
           is_write(is_write) {}
     Transaction(const Transaction& tran)
         : addr(tran.addr),
+          dram_addr(tran.dram_addr),
           added_cycle(tran.added_cycle),
           complete_cycle(tran.complete_cycle),
           is_write(tran.is_write) {}
     uint64_t addr;
+    Address dram_addr;  // decoded once when the controller accepts it
     uint64_t added_cycle;
     uint64_t complete_cycle;
     bool is_write;
@@ -174,6 +174,13 @@ void Config::InitOtherParams() {
     // 1: default value, adds epoch CSV output on level 0
     // 2: adds histogram outputs in a different CSV format
     output_level = reader.GetInteger("other", "output_level", 1);
+    // json: epoch records as a JSON array, tsv: one compact row per record
+    // (see EpochWriter), for short epochs
+    epoch_format = reader.Get("other", "epoch_format", "json");
+    if (epoch_format != "json" && epoch_format != "tsv") {
+        std::cerr << "Unknown epoch_format " << epoch_format << std::endl;
+        AbruptExit(__FILE__, __LINE__);
+    }
     // Other Parameters
     // give a prefix instead of specify the output name one by one...
     // this would allow outputing to a directory and you can always override
@@ -190,6 +197,7 @@ void Config::InitOtherParams() {
         output_dir + reader.Get("other", "output_prefix", "dramsim3");
     json_stats_name = output_prefix + ".json";
     json_epoch_name = output_prefix + "epoch.json";
+    tsv_epoch_name = output_prefix + "epoch.tsv";
     txt_stats_name = output_prefix + ".txt";
     return;
 }
@@ -253,6 +261,16 @@ void Config::InitSystemParams() {
     trans_queue_size = GetInteger("system", "trans_queue_size", 32);
     unified_queue = reader.GetBoolean("system", "unified_queue", false);
     write_buf_size = GetInteger("system", "write_buf_size", 16);
+    // threads ticking channels in parallel; same [parallel] section as the
+    // native DRAM model, and likewise serial unless asked for
+    tick_threads = GetInteger("parallel", "tick_threads", 1);
+    if (tick_threads < 1) {
+        std::cerr << "tick_threads must be positive" << std::endl;
+        AbruptExit(__FILE__, __LINE__);
+    }
+    // channels are ticked this many cycles at a time (checked against
+    // read_delay in InitTimingParams)
+    merge_quantum = GetInteger("parallel", "merge_quantum", 1);
     
     std::string ref_policy =
         reader.Get("system", "refresh_policy", "RANK_LEVEL_STAGGERED");
@@ -377,6 +395,14 @@ void Config::InitTimingParams() {
     WL = AL + CWL;
     read_delay = RL + burst_cycle;
     write_delay = WL + burst_cycle;
+
+    // no read returns sooner than read_delay after it is issued, so a batch
+    // of at most read_delay cycles never holds back a callback
+    if (merge_quantum < 1 || merge_quantum > read_delay) {
+        std::cerr << "merge_quantum must be in [1, read_delay = " << read_delay
+                  << "]" << std::endl;
+        AbruptExit(__FILE__, __LINE__);
+    }
     return;
 }
 
@@ -544,12 +570,17 @@ void Config::InitMOATParams() {
     // [MOAT] Parameters
     moat_mode = reader.GetInteger("moat", "moat_mode", 0);
     moatth = reader.GetInteger("moat", "moatth", 64);
+    moat_qsize = reader.GetInteger("moat", "moat_qsize", 1);
+    // MOAT needs the counters; otherwise they only feed prac_per_tREFI
+    prac_enabled = moat_mode != 0 || reader.GetBoolean("alert", "prac_stats", false);
 
     std::cout << "[MOAT] moat_mode: " << moat_mode << std::endl;
     if (moat_mode != 0)
     {
         std::cout << "[MOAT] moatth: " << moatth << std::endl;
+        std::cout << "[MOAT] moat_qsize: " << moat_qsize << std::endl;
     }
+    std::cout << "[PRAC] prac_enabled: " << prac_enabled << std::endl;
     return;
 }
 
@@ -144,6 +144,8 @@ class Config {
     bool unified_queue;
     int trans_queue_size;
     int write_buf_size;
+    int tick_threads;
+    int merge_quantum;
     bool enable_self_refresh;
     int sref_threshold;
     bool aggressive_precharging_enabled;
@@ -169,6 +171,8 @@ class Config {
     // [MOAT] parameters
     int moat_mode;
     int moatth;
+    int moat_qsize;           // number of rows MOAT tracks for mitigation
+    bool prac_enabled;        // track per-row activation counters (PRAC)
 
     // [MIRZA] parameters
     int mirza_mode;
@@ -184,6 +188,8 @@ class Config {
     std::string output_prefix;
     std::string json_stats_name;
     std::string json_epoch_name;
+    std::string tsv_epoch_name;
+    std::string epoch_format;
     std::string txt_stats_name;
 
     // Computed parameters
@@ -1,4 +1,5 @@
 #include "controller.h"
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <limits>
@@ -15,23 +16,74 @@ Controller::Controller(int channel, const Config &config, const Timing &timing)
       clk_(0),
       config_(config),
       simple_stats_(config_, channel_id_),
-      channel_state_(config, timing, simple_stats_),
+      channel_state_(channel_id_, config, timing, simple_stats_),
       cmd_queue_(channel_id_, config, channel_state_, simple_stats_),
       refresh_(config, channel_state_),
 #ifdef THERMAL
       thermal_calc_(thermal_calc),
 #endif  // THERMAL
       is_unified_queue_(config.unified_queue),
+      inbox_reads_(0),
+      inbox_writes_(0),
+      return_seq_(0),
       row_buf_policy_(config.row_buf_policy),
+      idle_cycles_(0),
+      sref_event_clk_(0),
       last_trans_clk_(0),
       write_draining_(0) 
 {
+    num_cycles_stat_ = simple_stats_.GetCounterId("num_cycles");
+    num_reads_done_stat_ = simple_stats_.GetCounterId("num_reads_done");
+    num_writes_done_stat_ = simple_stats_.GetCounterId("num_writes_done");
+    hbm_dual_cmds_stat_ = simple_stats_.GetCounterId("hbm_dual_cmds");
+    num_write_drains_stat_ = simple_stats_.GetCounterId("num_write_drains");
+    num_opp_write_drains_stat_ = simple_stats_.GetCounterId("num_opp_write_drains");
+    num_opp_write_drains_post_10M_stat_ =
+        simple_stats_.GetCounterId("num_opp_write_drains_post_10M");
+    epoch_num_stat_ = simple_stats_.GetCounterId("epoch_num");
+
+    cmd_stats_.assign(static_cast<int>(CommandType::SIZE), -1);
+    auto set_cmd_stat = [this](CommandType c, const std::string& name) {
+        cmd_stats_[static_cast<int>(c)] = simple_stats_.GetCounterId(name);
+    };
+    set_cmd_stat(CommandType::READ, "num_read_cmds");
+    set_cmd_stat(CommandType::READ_PRECHARGE, "num_read_cmds");
+    set_cmd_stat(CommandType::WRITE, "num_write_cmds");
+    set_cmd_stat(CommandType::WRITE_PRECHARGE, "num_write_cmds");
+    set_cmd_stat(CommandType::ACTIVATE, "num_act_cmds");
+    set_cmd_stat(CommandType::RFMab, "num_rfmab_cmds");
+    set_cmd_stat(CommandType::RFMsb, "num_rfmsb_cmds");
+    set_cmd_stat(CommandType::PRECHARGE, "num_pre_cmds");
+    set_cmd_stat(CommandType::REFab, "num_refab_cmds");
+    set_cmd_stat(CommandType::REFsb, "num_refsb_cmds");
+    set_cmd_stat(CommandType::REFRESH_BANK, "num_refb_cmds");
+    set_cmd_stat(CommandType::SREF_ENTER, "num_srefe_cmds");
+    set_cmd_stat(CommandType::SREF_EXIT, "num_srefx_cmds");
+    num_read_row_hits_stat_ = simple_stats_.GetCounterId("num_read_row_hits");
+    num_write_row_hits_stat_ = simple_stats_.GetCounterId("num_write_row_hits");
+
+    sref_cycles_stat_ = simple_stats_.GetVecCounterId("sref_cycles");
+    all_bank_idle_cycles_stat_ = simple_stats_.GetVecCounterId("all_bank_idle_cycles");
+    rank_active_cycles_stat_ = simple_stats_.GetVecCounterId("rank_active_cycles");
+
+    read_latency_stat_ = simple_stats_.GetHistoId("read_latency");
+    write_latency_stat_ = simple_stats_.GetHistoId("write_latency");
+    interarrival_latency_stat_ = simple_stats_.GetHistoId("interarrival_latency");
+    t_btwn_write_drains_stat_ = simple_stats_.GetHistoId("t_btwn_write_drains");
+    t_btwn_opp_write_drains_stat_ = simple_stats_.GetHistoId("t_btwn_opp_write_drains");
+
     if (is_unified_queue_) {
         unified_queue_.reserve(config_.trans_queue_size);
     } else {
         read_queue_.reserve(config_.trans_queue_size);
         write_buffer_.reserve(config_.trans_queue_size);
     }
+    if (row_buf_policy_ == RowBufPolicy::SOFT_CLOSE_PAGE) {
+        int num_banks = config_.ranks * config_.banks;
+        unified_rows_.resize(is_unified_queue_ ? num_banks : 0);
+        read_rows_.resize(is_unified_queue_ ? 0 : num_banks);
+        write_rows_.resize(is_unified_queue_ ? 0 : num_banks);
+    }
 
 #ifdef CMD_TRACE
     std::string trace_file_name = config_.output_prefix + "ch_" +
@@ -42,29 +94,60 @@ Controller::Controller(int channel, const Config &config, const Timing &timing)
 }
 
 std::pair<uint64_t, int> Controller::ReturnDoneTrans(uint64_t clk) {
-    auto it = return_queue_.begin();
-    while (it != return_queue_.end()) {
-        if (clk >= it->complete_cycle) {
-            if (it->is_write) {
-                simple_stats_.Increment("num_writes_done");
-            } else {
-                simple_stats_.Increment("num_reads_done");
-                simple_stats_.AddValue("read_latency", clk_ - it->added_cycle);
-            }
-            auto pair = std::make_pair(it->addr, it->is_write);
-            it = return_queue_.erase(it);
-            return pair;
-        } else {
-            ++it;
+    // take whichever queue holds the earliest completion
+    bool from_acks;
+    if (ack_queue_.empty()) {
+        if (return_queue_.empty()) {
+            return std::make_pair(-1, -1);
         }
+        from_acks = false;
+    } else {
+        from_acks = return_queue_.empty() ||
+                    return_queue_.top() > ack_queue_.front();
+    }
+    const Transaction &trans =
+        from_acks ? ack_queue_.front().trans : return_queue_.top().trans;
+    if (clk < trans.complete_cycle) {
+        return std::make_pair(-1, -1);
     }
-    return std::make_pair(-1, -1);
+    if (trans.is_write) {
+        simple_stats_.Increment(num_writes_done_stat_);
+    } else {
+        simple_stats_.Increment(num_reads_done_stat_);
+        simple_stats_.AddValue(read_latency_stat_, clk - trans.added_cycle);
+    }
+    auto pair = std::make_pair(trans.addr, trans.is_write);
+    if (from_acks) {
+        ack_queue_.pop_front();
+    } else {
+        return_queue_.pop();
+    }
+    return pair;
+}
+
+void Controller::ScheduleReturn(const Transaction &trans) {
+    return_queue_.push(ReturnEntry{trans, return_seq_++});
+}
+
+void Controller::ScheduleAck(const Transaction &trans) {
+    ack_queue_.push_back(ReturnEntry{trans, return_seq_++});
 }
 
 void Controller::ClockTick() {
+    AcceptTransactions();
     // update refresh counter
     refresh_.ClockTick();
 
+    // fast path: with nothing to schedule the command/power logic below would
+    // only bump cycle counters, so defer those and apply them in bulk
+    if (clk_ < sref_event_clk_ && IsIdle()) {
+        idle_cycles_++;
+        clk_++;
+        cmd_queue_.ClockTick();
+        return;
+    }
+    FlushIdleCycles();
+
     bool cmd_issued = false;
     Command cmd;
     if (channel_state_.IsRefreshWaiting()) {
@@ -87,7 +170,7 @@ void Controller::ClockTick() {
             if (second_cmd.IsValid()) {
                 if (second_cmd.IsReadWrite() != cmd.IsReadWrite()) {
                     IssueCommand(second_cmd);
-                    simple_stats_.Increment("hbm_dual_cmds");
+                    simple_stats_.Increment(hbm_dual_cmds_stat_);
                 }
             }
         }
@@ -96,14 +179,14 @@ void Controller::ClockTick() {
     // power updates pt 1
     for (int i = 0; i < config_.ranks; i++) {
         if (channel_state_.IsRankSelfRefreshing(i)) {
-            simple_stats_.IncrementVec("sref_cycles", i);
+            simple_stats_.IncrementVec(sref_cycles_stat_, i);
         } else {
             bool all_idle = channel_state_.IsAllBankIdleInRank(i);
             if (all_idle) {
-                simple_stats_.IncrementVec("all_bank_idle_cycles", i);
+                simple_stats_.IncrementVec(all_bank_idle_cycles_stat_, i);
                 channel_state_.rank_idle_cycles[i] += 1;
             } else {
-                simple_stats_.IncrementVec("rank_active_cycles", i);
+                simple_stats_.IncrementVec(rank_active_cycles_stat_, i);
                 // reset
                 channel_state_.rank_idle_cycles[i] = 0;
             }
@@ -145,60 +228,125 @@ void Controller::ClockTick() {
     ScheduleTransaction();
     clk_++;
     cmd_queue_.ClockTick();
-    simple_stats_.Increment("num_cycles");
+    simple_stats_.Increment(num_cycles_stat_);
+    UpdateSrefEventClk();
     return;
 }
 
+bool Controller::IsIdle() const {
+    return !channel_state_.IsRefreshWaiting() &&
+           !channel_state_.IsRFMWaiting() && unified_queue_.empty() &&
+           read_queue_.empty() && write_buffer_.empty() &&
+           cmd_queue_.QueueEmpty() && inbox_.empty();
+}
+
+void Controller::FlushIdleCycles() {
+    if (idle_cycles_ == 0) {
+        return;
+    }
+    // no commands were issued while idle, so every rank stayed in the state
+    // it was in when the controller went idle
+    for (int i = 0; i < config_.ranks; i++) {
+        if (channel_state_.IsRankSelfRefreshing(i)) {
+            simple_stats_.IncrementVecBy(sref_cycles_stat_, i, idle_cycles_);
+        } else if (channel_state_.IsAllBankIdleInRank(i)) {
+            simple_stats_.IncrementVecBy(all_bank_idle_cycles_stat_, i,
+                                         idle_cycles_);
+            channel_state_.rank_idle_cycles[i] += idle_cycles_;
+        } else {
+            simple_stats_.IncrementVecBy(rank_active_cycles_stat_, i,
+                                         idle_cycles_);
+            channel_state_.rank_idle_cycles[i] = 0;
+        }
+    }
+    simple_stats_.IncrementBy(num_cycles_stat_, idle_cycles_);
+    idle_cycles_ = 0;
+}
+
+void Controller::UpdateSrefEventClk() {
+    sref_event_clk_ = std::numeric_limits<uint64_t>::max();
+    if (!config_.enable_self_refresh) {
+        return;
+    }
+    for (int i = 0; i < config_.ranks; i++) {
+        if (channel_state_.IsRankSelfRefreshing(i)) {
+            if (!cmd_queue_.rank_q_empty[i]) {
+                sref_event_clk_ = clk_;
+                return;
+            }
+        } else if (cmd_queue_.rank_q_empty[i] &&
+                   channel_state_.IsAllBankIdleInRank(i)) {
+            // the next tick counts one more idle cycle before checking
+            int left = config_.sref_threshold -
+                       channel_state_.rank_idle_cycles[i] - 1;
+            sref_event_clk_ =
+                std::min(sref_event_clk_, clk_ + std::max(left, 0));
+        }
+    }
+}
+
 bool Controller::WillAcceptTransaction(uint64_t hex_addr, bool is_write) const {
     if (is_unified_queue_) {
-        return unified_queue_.size() < unified_queue_.capacity();
+        return unified_queue_.size() + inbox_.size() < unified_queue_.capacity();
     } else if (!is_write) {
-        return read_queue_.size() < read_queue_.capacity();
+        return read_queue_.size() + inbox_reads_ < read_queue_.capacity();
     } else {
 #ifdef WB_HAS_INF_CAPACITY
         return true;
 #else
-        return write_buffer_.size() < write_buffer_.capacity();
+        return write_buffer_.size() + inbox_writes_ < write_buffer_.capacity();
 #endif
     }
 }
 
-bool Controller::AddTransaction(Transaction trans) {
-    trans.added_cycle = clk_;
-    simple_stats_.AddValue("interarrival_latency", clk_ - last_trans_clk_);
-    last_trans_clk_ = clk_;
+bool Controller::AddTransaction(Transaction trans, uint64_t clk) {
+    trans.added_cycle = clk;
+    trans.dram_addr = config_.AddressMapping(trans.addr);
+    simple_stats_.AddValue(interarrival_latency_stat_, clk - last_trans_clk_);
+    last_trans_clk_ = clk;
 
     if (trans.is_write) {
         if (pending_wr_q_.count(trans.addr) == 0) {  // can not merge writes
-            pending_wr_q_.insert(std::make_pair(trans.addr, trans));
-            if (is_unified_queue_) {
-                unified_queue_.push_back(trans);
-            } else {
-                write_buffer_.push_back(trans);
-            }
+            pending_wr_q_.emplace(trans.addr, trans);
+            inbox_.push_back(trans);
+            inbox_writes_++;
         }
-        trans.complete_cycle = clk_ + 1;
-        return_queue_.push_back(trans);
+        trans.complete_cycle = clk + 1;
+        ScheduleAck(trans);
         return true;
     } else {  // read
         // if in write buffer, use the write buffer value
         if (pending_wr_q_.count(trans.addr) > 0) {
-            trans.complete_cycle = clk_ + 1;
-            return_queue_.push_back(trans);
+            trans.complete_cycle = clk + 1;
+            ScheduleAck(trans);
             return true;
         }
-        pending_rd_q_.insert(std::make_pair(trans.addr, trans));
-        if (pending_rd_q_.count(trans.addr) == 1) {
-            if (is_unified_queue_) {
-                unified_queue_.push_back(trans);
-            } else {
-                read_queue_.push_back(trans);
-            }
+        auto &reads = pending_rd_q_[trans.addr];
+        reads.push_back(trans);
+        if (reads.size() == 1) {
+            inbox_.push_back(trans);
+            inbox_reads_++;
         }
         return true;
     }
 }
 
+void Controller::AcceptTransactions() {
+    while (!inbox_.empty() && inbox_.front().added_cycle <= clk_) {
+        const Transaction &trans = inbox_.front();
+        if (trans.is_write) {
+            QueueTransaction(is_unified_queue_ ? unified_queue_ : write_buffer_,
+                             trans);
+            inbox_writes_--;
+        } else {
+            QueueTransaction(is_unified_queue_ ? unified_queue_ : read_queue_,
+                             trans);
+            inbox_reads_--;
+        }
+        inbox_.pop_front();
+    }
+}
+
 void Controller::ScheduleTransaction() {
     // determine whether to schedule read or write
     if (write_draining_ == 0 && !is_unified_queue_) {
@@ -212,15 +360,15 @@ void Controller::ScheduleTransaction() {
         {
             write_draining_ = write_buffer_.size();
 
-            simple_stats_.Increment("num_write_drains");
-            simple_stats_.AddValue("t_btwn_write_drains", clk_ - clk_last_write_drain_);
+            simple_stats_.Increment(num_write_drains_stat_);
+            simple_stats_.AddValue(t_btwn_write_drains_stat_, clk_ - clk_last_write_drain_);
             clk_last_write_drain_ = clk_;
             if (cmd_queue_.QueueEmpty()) {
-                simple_stats_.Increment("num_opp_write_drains");
+                simple_stats_.Increment(num_opp_write_drains_stat_);
                 if (clk_ > 10'000'000) {
-                    simple_stats_.Increment("num_opp_write_drains_post_10M");
+                    simple_stats_.Increment(num_opp_write_drains_post_10M_stat_);
                 }
-                simple_stats_.AddValue("t_btwn_opp_write_drains", clk_ - clk_last_opp_write_drain_);
+                simple_stats_.AddValue(t_btwn_opp_write_drains_stat_, clk_ - clk_last_opp_write_drain_);
                 clk_last_opp_write_drain_ = clk_;
             }
         }
@@ -230,9 +378,10 @@ void Controller::ScheduleTransaction() {
         is_unified_queue_ ? unified_queue_
                           : write_draining_ > 0 ? write_buffer_ : read_queue_;
     for (auto it = queue.begin(); it != queue.end(); it++) {
-        auto cmd = TransToCommand(it, queue);
-        if (cmd_queue_.WillAcceptCommand(cmd.Rank(), cmd.Bankgroup(),
-                                         cmd.Bank())) {
+        const Address &addr = it->dram_addr;
+        if (cmd_queue_.WillAcceptCommand(addr.rank, addr.bankgroup,
+                                         addr.bank)) {
+            auto cmd = TransToCommand(it, queue);
             if (!is_unified_queue_ && cmd.IsWrite()) {
                 // Enforce R->W dependency
                 if (pending_rd_q_.count(it->addr) > 0) {
@@ -242,12 +391,42 @@ void Controller::ScheduleTransaction() {
                 write_draining_ -= 1;
             }
             cmd_queue_.AddCommand(cmd);
-            queue.erase(it);
+            DequeueTransaction(queue, it);
             break;
         }
     }
 }
 
+void Controller::QueueTransaction(TransQueue &queue, const Transaction &trans) {
+    queue.push_back(trans);
+    if (row_buf_policy_ == RowBufPolicy::SOFT_CLOSE_PAGE) {
+        BankRowCounts(queue, trans.dram_addr)[trans.dram_addr.row]++;
+    }
+}
+
+void Controller::DequeueTransaction(TransQueue &queue,
+                                    const TransIterator &trans_it) {
+    if (row_buf_policy_ == RowBufPolicy::SOFT_CLOSE_PAGE) {
+        auto &rows = BankRowCounts(queue, trans_it->dram_addr);
+        auto row_it = rows.find(trans_it->dram_addr.row);
+        if (--row_it->second == 0) {
+            rows.erase(row_it);
+        }
+    }
+    queue.erase(trans_it);
+}
+
+std::unordered_map<int, int> &Controller::BankRowCounts(
+    const TransQueue &queue, const Address &addr) {
+    int bank = (addr.rank * config_.bankgroups + addr.bankgroup) *
+                   config_.banks_per_group +
+               addr.bank;
+    if (&queue == &unified_queue_) {
+        return unified_rows_[bank];
+    }
+    return &queue == &read_queue_ ? read_rows_[bank] : write_rows_[bank];
+}
+
 void Controller::IssueCommand(const Command &cmd) {
 #ifdef CMD_TRACE
     cmd_trace_ << std::left << std::setw(18) << clk_ << " " << cmd << std::endl;
@@ -258,19 +437,17 @@ void Controller::IssueCommand(const Command &cmd) {
 #endif  // THERMAL
     // if read/write, update pending queue and return queue
     if (cmd.IsRead()) {
-        auto num_reads = pending_rd_q_.count(cmd.hex_addr);
-        if (num_reads == 0) {
+        auto it = pending_rd_q_.find(cmd.hex_addr);
+        if (it == pending_rd_q_.end()) {
             std::cerr << cmd.hex_addr << " not in read queue! " << std::endl;
             exit(1);
         }
         // if there are multiple reads pending return them all
-        while (num_reads > 0) {
-            auto it = pending_rd_q_.find(cmd.hex_addr);
-            it->second.complete_cycle = clk_ + config_.read_delay;
-            return_queue_.push_back(it->second);
-            pending_rd_q_.erase(it);
-            num_reads -= 1;
+        for (auto &trans : it->second) {
+            trans.complete_cycle = clk_ + config_.read_delay;
+            ScheduleReturn(trans);
         }
+        pending_rd_q_.erase(it);
     } else if (cmd.IsWrite()) {
         // there should be only 1 write to the same location at a time
         auto it = pending_wr_q_.find(cmd.hex_addr);
@@ -279,17 +456,18 @@ void Controller::IssueCommand(const Command &cmd) {
             exit(1);
         }
         auto wr_lat = clk_ - it->second.added_cycle + config_.write_delay;
-        simple_stats_.AddValue("write_latency", wr_lat);
+        simple_stats_.AddValue(write_latency_stat_, wr_lat);
         pending_wr_q_.erase(it);
     }
     // must update stats before states (for row hits)
     UpdateCommandStats(cmd);
     channel_state_.UpdateTimingAndStates(cmd, clk_);
+    cmd_queue_.InvalidateReadyTimes(cmd);
 }
 
 Command Controller::TransToCommand(const TransIterator &trans_it, const TransQueue &queue) {
-    auto trans = *trans_it;
-    auto addr = config_.AddressMapping(trans.addr);
+    const Transaction &trans = *trans_it;
+    const Address &addr = trans.dram_addr;
     
     // OPEN_PAGE
     CommandType cmd_type = trans.is_write ? CommandType::WRITE : CommandType::READ;
@@ -302,18 +480,10 @@ Command Controller::TransToCommand(const TransIterator &trans_it, const TransQue
     else if (row_buf_policy_ == RowBufPolicy::SOFT_CLOSE_PAGE)
     {
         // if there is a request to the same row in the queue, we issue a
-        // read/write command, otherwise we issue a read/write precharge
-        bool request_exist = false;
-        for (auto pending_itr = std::next(trans_it); pending_itr != queue.end(); pending_itr++) {
-            auto pending_addr = config_.AddressMapping(pending_itr->addr);
-            if (pending_addr.row == addr.row &&
-                pending_addr.rank == addr.rank &&
-                pending_addr.bankgroup == addr.bankgroup &&
-                pending_addr.bank == addr.bank) {
-                request_exist = true;
-                break;
-            }
-        }
+        // read/write command, otherwise we issue a read/write precharge.
+        // Nothing to this bank sits ahead of trans_it (it would have been
+        // scheduled first), so any other request to the row comes after it
+        bool request_exist = BankRowCounts(queue, addr).at(addr.row) > 1;
 
         if (request_exist)
         {
@@ -330,9 +500,10 @@ Command Controller::TransToCommand(const TransIterator &trans_it, const TransQue
 
 int Controller::QueueUsage() const { return cmd_queue_.QueueUsage(); }
 
-void Controller::PrintEpochStats() {
-    simple_stats_.Increment("epoch_num");
-    simple_stats_.PrintEpochStats();
+void Controller::PrintEpochStats(EpochWriter &writer) {
+    FlushIdleCycles();
+    simple_stats_.Increment(epoch_num_stat_);
+    simple_stats_.PrintEpochStats(writer);
 #ifdef THERMAL
     for (int r = 0; r < config_.ranks; r++) {
         double bg_energy = simple_stats_.RankBackgroundEnergy(r);
@@ -343,6 +514,7 @@ void Controller::PrintEpochStats() {
 }
 
 void Controller::PrintFinalStats(bool stdout) {
+    FlushIdleCycles();
     simple_stats_.PrintFinalStats(stdout);
 
 #ifdef THERMAL
@@ -360,52 +532,17 @@ void Controller::PrintDeadlock() const {
 }
 
 void Controller::UpdateCommandStats(const Command &cmd) {
-    switch (cmd.cmd_type) {
-        case CommandType::READ:
-        case CommandType::READ_PRECHARGE:
-            simple_stats_.Increment("num_read_cmds");
-            if (channel_state_.RowHitCount(cmd.Rank(), cmd.Bankgroup(),
-                                           cmd.Bank()) != 0) {
-                simple_stats_.Increment("num_read_row_hits");
-            }
-            break;
-        case CommandType::WRITE:
-        case CommandType::WRITE_PRECHARGE:
-            simple_stats_.Increment("num_write_cmds");
-            if (channel_state_.RowHitCount(cmd.Rank(), cmd.Bankgroup(),
-                                           cmd.Bank()) != 0) {
-                simple_stats_.Increment("num_write_row_hits");
-            }
-            break;
-        case CommandType::ACTIVATE:
-            simple_stats_.Increment("num_act_cmds");
-            break;
-        case CommandType::RFMab:
-            simple_stats_.Increment("num_rfmab_cmds");
-            break;
-        case CommandType::RFMsb:
-            simple_stats_.Increment("num_rfmsb_cmds");
-            break;
-        case CommandType::PRECHARGE:
-            simple_stats_.Increment("num_pre_cmds");
-            break;
-        case CommandType::REFab:
-            simple_stats_.Increment("num_refab_cmds");
-            break;
-        case CommandType::REFsb:
-            simple_stats_.Increment("num_refsb_cmds");
-            break;
-        case CommandType::REFRESH_BANK:
-            simple_stats_.Increment("num_refb_cmds");
-            break;
-        case CommandType::SREF_ENTER:
-            simple_stats_.Increment("num_srefe_cmds");
-            break;
-        case CommandType::SREF_EXIT:
-            simple_stats_.Increment("num_srefx_cmds");
-            break;
-        default:
-            AbruptExit(__FILE__, __LINE__);
+    StatId id = cmd_stats_[static_cast<int>(cmd.cmd_type)];
+    if (id < 0) {
+        AbruptExit(__FILE__, __LINE__);
+    }
+    simple_stats_.Increment(id);
+    if (cmd.IsRead() || cmd.IsWrite()) {
+        if (channel_state_.RowHitCount(cmd.Rank(), cmd.Bankgroup(),
+                                       cmd.Bank()) != 0) {
+            simple_stats_.Increment(cmd.IsRead() ? num_read_row_hits_stat_
+                                                 : num_write_row_hits_stat_);
+        }
     }
 }
 
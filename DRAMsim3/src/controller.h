@@ -1,8 +1,10 @@
 #ifndef __CONTROLLER_H
 #define __CONTROLLER_H
 
+#include <deque>
 #include <fstream>
-#include <map>
+#include <queue>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include "channel_state.h"
@@ -29,13 +31,23 @@ class Controller {
     Controller(int channel, const Config &config, const Timing &timing);
 #endif  // THERMAL
     void ClockTick();
+    // nothing queued and no refresh/RFM pending, so a tick only advances clocks
+    bool IsIdle() const;
     bool WillAcceptTransaction(uint64_t hex_addr, bool is_write) const;
-    bool AddTransaction(Transaction trans);
+    // `clk` is the cycle the transaction arrives in, which may be ahead of
+    // clk_ if the controller is ticked several cycles at a time (see
+    // JedecDRAMSystem). Write acks and write buffer hits are returned at clk+1
+    // right away; everything else is queued once clk_ reaches clk.
+    bool AddTransaction(Transaction trans, uint64_t clk);
+    bool AddTransaction(Transaction trans) { return AddTransaction(trans, clk_); }
     int QueueUsage() const;
     // Stats output
-    void PrintEpochStats();
+    void PrintEpochStats(EpochWriter &writer);
     void PrintFinalStats(bool stdout);
-    void ResetStats() { simple_stats_.Reset(); }
+    void ResetStats() {
+        FlushIdleCycles();
+        simple_stats_.Reset();
+    }
     void PrintDeadlock() const;
     std::pair<uint64_t, int> ReturnDoneTrans(uint64_t clock);
 
@@ -62,26 +74,91 @@ class Controller {
     uint64_t clk_last_write_drain_ =0;
     uint64_t clk_last_opp_write_drain_ =0;
 
-    // transactions that are not completed, use map for convenience
-    std::multimap<uint64_t, Transaction> pending_rd_q_;
-    std::multimap<uint64_t, Transaction> pending_wr_q_;
-
-    // completed transactions
-    TransQueue return_queue_;
+    // transactions that are not completed, hashed by address (reads to the
+    // same address are kept in arrival order)
+    std::unordered_map<uint64_t, std::vector<Transaction> > pending_rd_q_;
+    std::unordered_map<uint64_t, Transaction> pending_wr_q_;
+
+    // transactions added but not yet queued, in arrival (added_cycle) order,
+    // and how many of them are reads and writes
+    std::deque<Transaction> inbox_;
+    size_t inbox_reads_;
+    size_t inbox_writes_;
+    void AcceptTransactions();
+
+    // completed transactions, returned in (complete_cycle, arrival) order
+    struct ReturnEntry {
+        Transaction trans;
+        uint64_t seq;
+        bool operator>(const ReturnEntry &other) const {
+            return trans.complete_cycle != other.trans.complete_cycle
+                       ? trans.complete_cycle > other.trans.complete_cycle
+                       : seq > other.seq;
+        }
+    };
+    std::priority_queue<ReturnEntry, std::vector<ReturnEntry>,
+                        std::greater<ReturnEntry> >
+        return_queue_;
+    // fast path for write acks and write buffer hits, which complete on the
+    // next cycle and so are already in order
+    std::deque<ReturnEntry> ack_queue_;
+    uint64_t return_seq_;
 
     // row buffer policy
     RowBufPolicy row_buf_policy_;
 
+    // [SOFT_CLOSE_PAGE] number of queued transactions per bank and row, one
+    // table per transaction queue, so the policy needn't rescan the queue
+    using RowCounts = std::vector<std::unordered_map<int, int> >;
+    RowCounts unified_rows_;
+    RowCounts read_rows_;
+    RowCounts write_rows_;
+    std::unordered_map<int, int> &BankRowCounts(const TransQueue &queue,
+                                                const Address &addr);
+
+    // stat handles, resolved once so per-cycle updates don't hash names
+    StatId num_cycles_stat_;
+    StatId num_reads_done_stat_;
+    StatId num_writes_done_stat_;
+    StatId hbm_dual_cmds_stat_;
+    StatId num_write_drains_stat_;
+    StatId num_opp_write_drains_stat_;
+    StatId num_opp_write_drains_post_10M_stat_;
+    StatId epoch_num_stat_;
+    // indexed by CommandType (-1 if the command is not counted)
+    std::vector<StatId> cmd_stats_;
+    StatId num_read_row_hits_stat_;
+    StatId num_write_row_hits_stat_;
+    StatId sref_cycles_stat_;
+    StatId all_bank_idle_cycles_stat_;
+    StatId rank_active_cycles_stat_;
+    StatId read_latency_stat_;
+    StatId write_latency_stat_;
+    StatId interarrival_latency_stat_;
+    StatId t_btwn_write_drains_stat_;
+    StatId t_btwn_opp_write_drains_stat_;
+
 #ifdef CMD_TRACE
     std::ofstream cmd_trace_;
 #endif  // CMD_TRACE
 
+    // idle ticks whose cycle-weighted stats have not been applied yet, and the
+    // first cycle at which an idle rank may enter (or must exit) self refresh
+    uint64_t idle_cycles_;
+    uint64_t sref_event_clk_;
+    void FlushIdleCycles();
+    void UpdateSrefEventClk();
+
     // used to calculate inter-arrival latency
     uint64_t last_trans_clk_;
 
     // transaction queueing
     int write_draining_;
     void ScheduleTransaction();
+    void QueueTransaction(TransQueue &queue, const Transaction &trans);
+    void DequeueTransaction(TransQueue &queue, const TransIterator &trans_it);
+    void ScheduleReturn(const Transaction &trans);
+    void ScheduleAck(const Transaction &trans);
     void IssueCommand(const Command &tmp_cmd);
     Command TransToCommand(const TransIterator &trans_it, const TransQueue &queue);
     void UpdateCommandStats(const Command &cmd);
@@ -1,6 +1,7 @@
 #include "dram_system.h"
 
 #include <assert.h>
+#include <algorithm>
 
 namespace dramsim3 {
 
@@ -19,7 +20,8 @@ BaseDRAMSystem::BaseDRAMSystem(Config &config, const std::string &output_dir,
 #ifdef THERMAL
       thermal_calc_(config_),
 #endif  // THERMAL
-      clk_(0) {
+      clk_(0),
+      epoch_writer_(config_) {
     total_channels_ += config_.channels;
 
 #ifdef ADDR_TRACE
@@ -34,15 +36,8 @@ int BaseDRAMSystem::GetChannel(uint64_t hex_addr) const {
 }
 
 void BaseDRAMSystem::PrintEpochStats() {
-    // first epoch, print bracket
-    if (clk_ - config_.epoch_period == 0) {
-        std::ofstream epoch_out(config_.json_epoch_name, std::ofstream::out);
-        epoch_out << "[";
-    }
     for (size_t i = 0; i < ctrls_.size(); i++) {
-        ctrls_[i]->PrintEpochStats();
-        std::ofstream epoch_out(config_.json_epoch_name, std::ofstream::app);
-        epoch_out << "," << std::endl;
+        ctrls_[i]->PrintEpochStats(epoch_writer_);
     }
 #ifdef THERMAL
     thermal_calc_.PrintTransPT(clk_);
@@ -51,13 +46,7 @@ void BaseDRAMSystem::PrintEpochStats() {
 }
 
 void BaseDRAMSystem::PrintStats(bool stdout) {
-    // Finish epoch output, remove last comma and append ]
-    std::ofstream epoch_out(config_.json_epoch_name, std::ios_base::in |
-                                                         std::ios_base::out |
-                                                         std::ios_base::ate);
-    epoch_out.seekp(-2, std::ios_base::cur);
-    epoch_out.write("]", 1);
-    epoch_out.close();
+    epoch_writer_.Close();
 
     std::ofstream json_out(config_.json_stats_name, std::ofstream::out);
     json_out << "{";
@@ -103,7 +92,11 @@ void BaseDRAMSystem::RegisterCallbacks(
 JedecDRAMSystem::JedecDRAMSystem(Config &config, const std::string &output_dir,
                                  std::function<void(uint64_t)> read_callback,
                                  std::function<void(uint64_t)> write_callback)
-    : BaseDRAMSystem(config, output_dir, read_callback, write_callback) {
+    : BaseDRAMSystem(config, output_dir, read_callback, write_callback),
+      clks_since_tick_(0),
+      tick_epoch_(0),
+      num_workers_done_(0),
+      workers_should_exit_(false) {
     if (config_.IsHMC()) {
         std::cerr << "Initialized a memory system with an HMC config file!"
                   << std::endl;
@@ -118,9 +111,25 @@ JedecDRAMSystem::JedecDRAMSystem(Config &config, const std::string &output_dir,
         ctrls_.push_back(new Controller(i, config_, timing_));
 #endif  // THERMAL
     }
+
+    // never use more threads than channels or hardware threads
+    size_t n_hw_threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t n_threads = std::min({static_cast<size_t>(config_.tick_threads),
+                                 ctrls_.size(), n_hw_threads});
+    for (size_t i = 0; i <= n_threads; i++) {
+        first_ctrl_.push_back((i * ctrls_.size()) / n_threads);
+    }
+    for (size_t i = 1; i < n_threads; i++) {
+        workers_.emplace_back(&JedecDRAMSystem::WorkerLoop, this, i);
+    }
 }
 
 JedecDRAMSystem::~JedecDRAMSystem() {
+    workers_should_exit_.store(true, std::memory_order_release);
+    ReleaseWorkers();
+    for (auto &t : workers_) {
+        t.join();
+    }
     for (auto it = ctrls_.begin(); it != ctrls_.end(); it++) {
         delete (*it);
     }
@@ -145,7 +154,7 @@ bool JedecDRAMSystem::AddTransaction(uint64_t hex_addr, bool is_write) {
     assert(ok);
     if (ok) {
         Transaction trans = Transaction(hex_addr, is_write);
-        ctrls_[channel]->AddTransaction(trans);
+        ctrls_[channel]->AddTransaction(trans, clk_);
     }
     last_req_clk_ = clk_;
     return ok;
@@ -165,8 +174,11 @@ void JedecDRAMSystem::ClockTick() {
             }
         }
     }
-    for (size_t i = 0; i < ctrls_.size(); i++) {
-        ctrls_[i]->ClockTick();
+    // controllers are ticked merge_quantum cycles at a time, once clk_ is the
+    // last cycle of the batch
+    if (++clks_since_tick_ == config_.merge_quantum) {
+        clks_since_tick_ = 0;
+        TickBatch();
     }
     clk_++;
 
@@ -176,6 +188,77 @@ void JedecDRAMSystem::ClockTick() {
     return;
 }
 
+void JedecDRAMSystem::TickBatch() {
+    // idle controllers tick in a few instructions, not worth a pool round trip
+    if (workers_.empty() ||
+        std::all_of(ctrls_.begin(), ctrls_.end(),
+                    [](const Controller *ctrl) { return ctrl->IsIdle(); })) {
+        for (size_t i = 0; i < ctrls_.size(); i++) {
+            for (int c = 0; c < config_.merge_quantum; c++) {
+                ctrls_[i]->ClockTick();
+            }
+        }
+        return;
+    }
+    num_workers_done_.store(0, std::memory_order_relaxed);
+    ReleaseWorkers();
+    TickCtrls(0);
+    size_t n = workers_.size();
+    for (int i = 0; i < kBarrierYields; i++) {
+        if (num_workers_done_.load(std::memory_order_acquire) == n) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+    std::unique_lock<std::mutex> lock(barrier_mutex_);
+    done_cv_.wait(lock, [this, n] {
+        return num_workers_done_.load(std::memory_order_acquire) == n;
+    });
+}
+
+void JedecDRAMSystem::TickCtrls(size_t worker_id) {
+    for (size_t i = first_ctrl_[worker_id]; i < first_ctrl_[worker_id + 1];
+         i++) {
+        for (int c = 0; c < config_.merge_quantum; c++) {
+            ctrls_[i]->ClockTick();
+        }
+    }
+}
+
+void JedecDRAMSystem::ReleaseWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(barrier_mutex_);
+        tick_epoch_.fetch_add(1, std::memory_order_release);
+    }
+    tick_cv_.notify_all();
+}
+
+void JedecDRAMSystem::WorkerLoop(size_t worker_id) {
+    uint64_t epoch = 0;
+    auto released = [this, &epoch] {
+        return tick_epoch_.load(std::memory_order_acquire) != epoch;
+    };
+    while (true) {
+        for (int i = 0; i < kBarrierYields && !released(); i++) {
+            std::this_thread::yield();
+        }
+        if (!released()) {
+            std::unique_lock<std::mutex> lock(barrier_mutex_);
+            tick_cv_.wait(lock, released);
+        }
+        epoch = tick_epoch_.load(std::memory_order_acquire);
+        if (workers_should_exit_.load(std::memory_order_acquire)) {
+            return;
+        }
+        TickCtrls(worker_id);
+        if (num_workers_done_.fetch_add(1, std::memory_order_acq_rel) + 1 ==
+            workers_.size()) {
+            std::lock_guard<std::mutex> lock(barrier_mutex_);
+            done_cv_.notify_one();
+        }
+    }
+}
+
 IdealDRAMSystem::IdealDRAMSystem(Config &config, const std::string &output_dir,
                                  std::function<void(uint64_t)> read_callback,
                                  std::function<void(uint64_t)> write_callback)
@@ -1,8 +1,12 @@
 #ifndef __DRAM_SYSTEM_H
 #define __DRAM_SYSTEM_H
 
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "common.h"
@@ -52,6 +56,7 @@ class BaseDRAMSystem {
 
     uint64_t clk_;
     std::vector<Controller*> ctrls_;
+    EpochWriter epoch_writer_;
 
 #ifdef ADDR_TRACE
     std::ofstream address_trace_;
@@ -68,6 +73,34 @@ class JedecDRAMSystem : public BaseDRAMSystem {
     bool WillAcceptTransaction(uint64_t hex_addr, bool is_write) const override;
     bool AddTransaction(uint64_t hex_addr, bool is_write) override;
     void ClockTick() override;
+
+   private:
+    // Controllers share no state, so they are ticked by a persistent pool
+    // after completions (and their callbacks) are drained on the calling
+    // thread. Thread i ticks ctrls_[first_ctrl_[i], first_ctrl_[i+1]); thread
+    // 0 is the caller of ClockTick.
+    //
+    // The pool is only woken every merge_quantum cycles, and each thread then
+    // ticks its controllers through the whole batch. Completions wait in the
+    // controllers' return queues until clk_ reaches them, and new transactions
+    // wait in their inboxes until the controller reaches the cycle they were
+    // added in. Threads waiting at the barrier yield kBarrierYields times and
+    // then sleep on tick_cv_ (workers) or done_cv_ (caller).
+    static constexpr int kBarrierYields = 256;
+    void TickBatch();
+    void TickCtrls(size_t worker_id);
+    void ReleaseWorkers();
+    void WorkerLoop(size_t worker_id);
+
+    int clks_since_tick_;
+    std::vector<std::thread> workers_;
+    std::vector<size_t> first_ctrl_;
+    std::atomic<uint64_t> tick_epoch_;
+    std::atomic<size_t> num_workers_done_;
+    std::atomic<bool> workers_should_exit_;
+    std::mutex barrier_mutex_;
+    std::condition_variable tick_cv_;
+    std::condition_variable done_cv_;
 };
 
 // Model a memorysystem with an infinite bandwidth and a fixed latency (possibly
@@ -0,0 +1,43 @@
+#include "epoch_writer.h"
+
+namespace dramsim3 {
+
+EpochWriter::EpochWriter(const Config& config)
+    : config_(config),
+      columnar_(config.epoch_format == "tsv"),
+      closed_(false),
+      num_records_(0),
+      buffer_(1 << 20) {}
+
+EpochWriter::~EpochWriter() { Close(); }
+
+std::ostream& EpochWriter::NextRecord() {
+    if (num_records_ == 0) {
+        // must be set before the file is opened to take effect
+        out_.rdbuf()->pubsetbuf(buffer_.data(), buffer_.size());
+        out_.open(columnar_ ? config_.tsv_epoch_name : config_.json_epoch_name,
+                  std::ofstream::out);
+        if (!columnar_) {
+            out_ << "[";
+        }
+    } else if (!columnar_) {
+        out_ << "," << '\n';
+    }
+    num_records_++;
+    return out_;
+}
+
+void EpochWriter::Close() {
+    if (closed_) {
+        return;
+    }
+    closed_ = true;
+    if (num_records_ > 0) {
+        if (!columnar_) {
+            out_ << "]" << '\n';
+        }
+        out_.close();
+    }
+}
+
+}  // namespace dramsim3
@@ -0,0 +1,42 @@
+#ifndef __EPOCH_WRITER_H
+#define __EPOCH_WRITER_H
+
+#include <stdint.h>
+#include <fstream>
+#include <vector>
+#include "configuration.h"
+
+namespace dramsim3 {
+
+// Sink for the per-channel stats records printed every epoch. The output file
+// is opened on the first record and kept open (and buffered) for the rest of
+// the run, so short epochs don't pay for reopening it on every record.
+//
+// epoch_format = json (default) writes the usual array of channel objects to
+// json_epoch_name. epoch_format = tsv writes one tab-separated row per channel
+// per epoch to tsv_epoch_name, which is much cheaper to produce. Before its
+// first row, each channel writes a "#<channel>" row naming its columns as
+// <type>:<name>. <type> is u (integer) or f (double), and uv/fv for element
+// <name>.<index> of a vector stat. scripts/epoch_tsv_to_json.py converts a TSV
+// file back to the JSON form.
+class EpochWriter {
+   public:
+    EpochWriter(const Config& config);
+    ~EpochWriter();
+    bool IsColumnar() const { return columnar_; }
+    // stream the next channel record goes to
+    std::ostream& NextRecord();
+    // terminate the output, no records can be written after this
+    void Close();
+
+   private:
+    const Config& config_;
+    bool columnar_;
+    bool closed_;
+    uint64_t num_records_;
+    std::vector<char> buffer_;
+    std::ofstream out_;
+};
+
+}  // namespace dramsim3
+#endif
@@ -0,0 +1,115 @@
+#include "mitigation_queue.h"
+
+namespace dramsim3 {
+
+MitigationQueue::MitigationQueue(size_t capacity)
+    : capacity_(capacity), next_seq_(0) {}
+
+void MitigationQueue::Offer(uint32_t rowid, uint32_t count) {
+    auto it = pos_.find(rowid);
+    if (it != pos_.end()) {
+        size_t i = it->second;
+        uint32_t old_count = heap_[i].count;
+        heap_[i].count = count;
+        if (count > old_count) {
+            SiftUp(i);
+        } else if (count < old_count) {
+            SiftDown(i);
+        }
+        return;
+    }
+    if (capacity_ > 0 && heap_.size() >= capacity_) {
+        size_t w = Weakest();
+        if (count <= heap_[w].count) {
+            return;
+        }
+        RemoveAt(w);
+    }
+    heap_.push_back(Entry{rowid, count, next_seq_++});
+    pos_[rowid] = heap_.size() - 1;
+    SiftUp(heap_.size() - 1);
+}
+
+void MitigationQueue::Remove(uint32_t rowid) {
+    auto it = pos_.find(rowid);
+    if (it != pos_.end()) {
+        RemoveAt(it->second);
+    }
+}
+
+void MitigationQueue::RemoveAt(size_t i) {
+    pos_.erase(heap_[i].rowid);
+    Entry last = heap_.back();
+    heap_.pop_back();
+    if (i == heap_.size()) {
+        return;
+    }
+    Place(i, last);
+    if (i > 0 && Before(heap_[i], heap_[(i - 1) / 2])) {
+        SiftUp(i);
+    } else {
+        SiftDown(i);
+    }
+}
+
+void MitigationQueue::SiftUp(size_t i) {
+    Entry e = heap_[i];
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (!Before(e, heap_[parent])) {
+            break;
+        }
+        Place(i, heap_[parent]);
+        i = parent;
+    }
+    Place(i, e);
+}
+
+void MitigationQueue::SiftDown(size_t i) {
+    Entry e = heap_[i];
+    size_t n = heap_.size();
+    while (true) {
+        size_t child = 2 * i + 1;
+        if (child >= n) {
+            break;
+        }
+        if (child + 1 < n && Before(heap_[child + 1], heap_[child])) {
+            child++;
+        }
+        if (!Before(heap_[child], e)) {
+            break;
+        }
+        Place(i, heap_[child]);
+        i = child;
+    }
+    Place(i, e);
+}
+
+void MitigationQueue::Place(size_t i, const Entry& e) {
+    heap_[i] = e;
+    pos_[e.rowid] = i;
+}
+
+void MitigationQueue::Rebuild() {
+    pos_.clear();
+    for (size_t i = 0; i < heap_.size(); i++) {
+        pos_[heap_[i].rowid] = i;
+    }
+    for (size_t i = heap_.size() / 2; i-- > 0;) {
+        SiftDown(i);
+    }
+}
+
+size_t MitigationQueue::Weakest() const {
+    // the weakest candidate is always a leaf; only called when the queue is
+    // full, so this is bounded by `capacity_`
+    size_t w = heap_.size() / 2;
+    for (size_t i = w + 1; i < heap_.size(); i++) {
+        if (Before(heap_[w], heap_[i])) {
+            w = i;
+        }
+    }
+    return w;
+}
+
+}  // namespace dramsim3
@@ -0,0 +1,74 @@
+#ifndef __MITIGATION_QUEUE_H
+#define __MITIGATION_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+namespace dramsim3 {
+
+// Row-hammer mitigation candidates (MIRZA queue, MOAT tracker) for one bank.
+//
+// An indexed max-heap keyed on each row's activation count, with a row id ->
+// heap slot map, so lookup is O(1), Top() is O(1), and count updates are
+// O(log n) in the number of candidates. Ties go to the earliest inserted row,
+// which matches scanning an insertion-ordered list for the first max.
+//
+// If `capacity` is nonzero, Offer() only admits a new row once the queue is
+// full if its count beats the weakest candidate, which is evicted.
+class MitigationQueue {
+   public:
+    struct Entry {
+        uint32_t rowid;
+        uint32_t count;
+        uint64_t seq;
+    };
+
+    MitigationQueue(size_t capacity = 0);
+
+    bool Empty() const { return heap_.empty(); }
+    size_t Size() const { return heap_.size(); }
+    bool Contains(uint32_t rowid) const { return pos_.count(rowid) > 0; }
+    uint32_t Count(uint32_t rowid) const { return heap_[pos_.at(rowid)].count; }
+    const Entry& Top() const { return heap_.front(); }
+
+    // Inserts `rowid` or updates its count if it is already a candidate.
+    void Offer(uint32_t rowid, uint32_t count);
+    void Pop() { RemoveAt(0); }
+    void Remove(uint32_t rowid);
+
+    template <class Pred>
+    void RemoveIf(Pred pred) {
+        size_t n = 0;
+        for (size_t i = 0; i < heap_.size(); i++) {
+            if (!pred(heap_[i])) {
+                heap_[n++] = heap_[i];
+            }
+        }
+        if (n != heap_.size()) {
+            heap_.resize(n);
+            Rebuild();
+        }
+    }
+
+   private:
+    // true if `a` should be mitigated before `b`
+    static bool Before(const Entry& a, const Entry& b) {
+        return a.count > b.count || (a.count == b.count && a.seq < b.seq);
+    }
+    void RemoveAt(size_t i);
+    void SiftUp(size_t i);
+    void SiftDown(size_t i);
+    void Place(size_t i, const Entry& e);
+    void Rebuild();
+    size_t Weakest() const;
+
+    size_t capacity_;
+    uint64_t next_seq_;
+    std::vector<Entry> heap_;
+    std::unordered_map<uint32_t, size_t> pos_;
+};
+
+}  // namespace dramsim3
+#endif
@@ -0,0 +1,39 @@
+#include "prac_counters.h"
+
+namespace dramsim3 {
+
+PRACCounters::PRACCounters(int rows) : rows_(rows) {}
+
+void PRACCounters::Set(int row, uint16_t value) {
+    if (block_idx_.empty()) {
+        if (value == 0) {
+            return;
+        }
+        block_idx_.assign((rows_ + kBlockRows - 1) / kBlockRows, -1);
+    }
+    int32_t& b = block_idx_[row >> kBlockBits];
+    if (b < 0) {
+        if (value == 0) {
+            return;
+        }
+        if (free_blocks_.empty()) {
+            b = blocks_.size();
+            blocks_.emplace_back();
+        } else {
+            b = free_blocks_.back();
+            free_blocks_.pop_back();
+        }
+        blocks_[b] = Block();
+    }
+
+    Block& block = blocks_[b];
+    uint16_t& count = block.count[row & (kBlockRows - 1)];
+    block.num_nonzero += (value != 0) - (count != 0);
+    count = value;
+    if (block.num_nonzero == 0) {
+        free_blocks_.push_back(b);
+        b = -1;
+    }
+}
+
+}  // namespace dramsim3
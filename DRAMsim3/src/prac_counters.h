@@ -0,0 +1,51 @@
+#ifndef __PRAC_COUNTERS_H
+#define __PRAC_COUNTERS_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace dramsim3 {
+
+// Per-row activation counters (PRAC) for one bank.
+//
+// Counters are stored sparsely in a two-level table: the top level maps each
+// block of kBlockRows rows to a block in a pool, and a block only exists while
+// one of its rows has a nonzero count. The table itself is allocated on the
+// first Increment(), so banks that never track PRAC cost nothing, and a bank's
+// footprint follows the rows activated since their last refresh instead of
+// `rows` (RAA/MOAT studies rarely touch more than a few percent of rows).
+class PRACCounters {
+   public:
+    PRACCounters(int rows);
+
+    uint16_t Get(int row) const {
+        if (block_idx_.empty()) {
+            return 0;
+        }
+        int32_t b = block_idx_[row >> kBlockBits];
+        return b < 0 ? 0 : blocks_[b].count[row & (kBlockRows - 1)];
+    }
+    void Increment(int row) { Set(row, Get(row) + 1); }
+    // Blocks whose counters all reach zero go back to the pool.
+    void Reset(int row) { Set(row, 0); }
+
+   private:
+    static constexpr int kBlockBits = 4;
+    static constexpr int kBlockRows = 1 << kBlockBits;
+
+    struct Block {
+        uint16_t count[kBlockRows];
+        uint16_t num_nonzero;
+    };
+
+    void Set(int row, uint16_t value);
+
+    int rows_;
+    // index into blocks_ (-1 if no row in the block has a nonzero count)
+    std::vector<int32_t> block_idx_;
+    std::vector<Block> blocks_;
+    std::vector<int32_t> free_blocks_;
+};
+
+}  // namespace dramsim3
+#endif
@@ -18,7 +18,7 @@ void PrintStatText(std::ostream& where, std::string name, T value,
 }
 
 SimpleStats::SimpleStats(const Config& config, int channel_id)
-    : config_(config), channel_id_(channel_id) {
+    : config_(config), channel_id_(channel_id), epoch_schema_written_(false) {
     // counter stats
     InitStat("num_cycles", "counter", "Number of DRAM cycles");
     InitStat("epoch_num", "counter", "Number of epochs");
@@ -50,8 +50,11 @@ SimpleStats::SimpleStats(const Config& config, int channel_id)
     InitStat("ref_energy", "double", "Refresh energy");
     InitStat("refb_energy", "double", "Refresh-bank energy");
 
-    InitVecStat("prac_per_tREFI", "vec_counter", "PRAC counters per tREFI", "geometric_bin", 13);
-    // 0, 1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, >= 1024
+    // Only meaningful when the counters are tracked (MOAT or [alert] prac_stats)
+    if (config_.prac_enabled) {
+        InitVecStat("prac_per_tREFI", "vec_counter", "PRAC counters per tREFI", "geometric_bin", 13);
+        // 0, 1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, >= 1024
+    }
 
     // Vector counter stats
     InitVecStat("all_bank_idle_cycles", "vec_counter",
@@ -95,13 +98,31 @@ SimpleStats::SimpleStats(const Config& config, int channel_id)
              "Average request interarrival latency (cycles)");
 }
 
-void SimpleStats::AddValue(const std::string name, const int value) {
-    auto& epoch_counts = epoch_histo_counts_[name];
-    if (epoch_counts.count(value) <= 0) {
-        epoch_counts[value] = 1;
-    } else {
-        epoch_counts[value] += 1;
+StatId SimpleStats::GetCounterId(const std::string& name) const {
+    auto it = counter_ids_.find(name);
+    if (it == counter_ids_.end()) {
+        std::cerr << "Unknown counter stat " << name << std::endl;
+        AbruptExit(__FILE__, __LINE__);
     }
+    return it->second;
+}
+
+StatId SimpleStats::GetVecCounterId(const std::string& name) const {
+    auto it = vec_counter_ids_.find(name);
+    if (it == vec_counter_ids_.end()) {
+        std::cerr << "Unknown vec counter stat " << name << std::endl;
+        AbruptExit(__FILE__, __LINE__);
+    }
+    return it->second;
+}
+
+StatId SimpleStats::GetHistoId(const std::string& name) const {
+    auto it = histo_ids_.find(name);
+    if (it == histo_ids_.end()) {
+        std::cerr << "Unknown histogram stat " << name << std::endl;
+        AbruptExit(__FILE__, __LINE__);
+    }
+    return it->second;
 }
 
 std::string SimpleStats::GetTextHeader(bool is_final) const {
@@ -110,7 +131,7 @@ std::string SimpleStats::GetTextHeader(bool is_final) const {
         "Channel " +
         std::to_string(channel_id_);
     if (!is_final) {
-        header += " of epoch " + std::to_string(counters_.at("epoch_num"));
+        header += " of epoch " + std::to_string(counters_[GetCounterId("epoch_num")]);
     }
     header += "\n###########################################\n";
     return header;
@@ -122,11 +143,19 @@ double SimpleStats::RankBackgroundEnergy(const int rank) const{
            vec_doubles_.at("sref_energy")[rank];
 }
 
-void SimpleStats::PrintEpochStats() {
+void SimpleStats::PrintEpochStats(EpochWriter& writer) {
     UpdateEpochStats();
+    bool columnar = writer.IsColumnar();
+    if (config_.output_level >= 2 ||
+        (config_.output_level >= 1 && !columnar)) {
+        UpdatePrints(true);
+    }
     if (config_.output_level >= 1) {
-        std::ofstream j_out(config_.json_epoch_name, std::ofstream::app);
-        j_out << j_data_;
+        if (columnar) {
+            WriteEpochColumns(writer.NextRecord());
+        } else {
+            writer.NextRecord() << j_data_;
+        }
     }
     if (config_.output_level >= 2) {
         std::cout << GetTextHeader(false);
@@ -135,9 +164,90 @@ void SimpleStats::PrintEpochStats() {
                           header_descs_[it.first]);
         }
     }
+    ClearEpochStats();
     print_pairs_.clear();
 }
 
+void SimpleStats::WriteEpochColumns(std::ostream& out) {
+    // calculated stats only exist once the first epoch has been computed, so
+    // the schema is written with the first row
+    if (!epoch_schema_written_) {
+        out << "#" << channel_id_ << "\t";
+        WriteEpochRow(out, true);
+        epoch_schema_written_ = true;
+    }
+    WriteEpochRow(out, false);
+}
+
+void SimpleStats::WriteEpochRow(std::ostream& out, bool names) const {
+    // walks the same stats in the same order as UpdatePrints(true). Doubles
+    // go through the JSON serializer so converting back is lossless
+    auto put_double = [&out](double value) { out << Json(value).dump(); };
+    if (names) {
+        out << "u:channel";
+    } else {
+        out << channel_id_;
+    }
+    StatId epoch_num_id = GetCounterId("epoch_num");
+    for (const auto& it : counter_ids_) {
+        if (names) {
+            out << "\tu:" << it.first;
+        } else {
+            out << '\t'
+                << (it.second == epoch_num_id ? counters_[it.second]
+                                              : epoch_counters_[it.second]);
+        }
+    }
+    for (const auto& it : vec_counter_ids_) {
+        const auto& vec = epoch_vec_counters_[it.second];
+        for (size_t i = 0; i < vec.size(); i++) {
+            if (names) {
+                out << "\tuv:" << it.first << "." << i;
+            } else {
+                out << '\t' << vec[i];
+            }
+        }
+    }
+    for (const auto& it : histo_ids_) {
+        const auto& headers = histo_headers_[it.second];
+        const auto& bins = epoch_histo_bins_[it.second];
+        for (size_t i = 0; i < bins.size(); i++) {
+            if (names) {
+                out << "\tu:" << headers[i];
+            } else {
+                out << '\t' << bins[i];
+            }
+        }
+    }
+    for (const auto& it : doubles_) {
+        if (names) {
+            out << "\tf:" << it.first;
+        } else {
+            out << '\t';
+            put_double(it.second);
+        }
+    }
+    for (const auto& it : vec_doubles_) {
+        for (size_t i = 0; i < it.second.size(); i++) {
+            if (names) {
+                out << "\tfv:" << it.first << "." << i;
+            } else {
+                out << '\t';
+                put_double(it.second[i]);
+            }
+        }
+    }
+    for (const auto& it : calculated_) {
+        if (names) {
+            out << "\tf:" << it.first;
+        } else {
+            out << '\t';
+            put_double(it.second);
+        }
+    }
+    out << '\n';
+}
+
 void SimpleStats::PrintFinalStats(bool stdout) {
     UpdateFinalStats();
 
@@ -171,17 +281,13 @@ void SimpleStats::PrintFinalStats(bool stdout) {
 }
 
 void SimpleStats::Reset() {
-    for (auto& it : counters_) {
-        it.second = 0;
-    }
-    for (auto& it : epoch_counters_) {
-        it.second = 0;
-    }
+    std::fill(counters_.begin(), counters_.end(), 0);
+    std::fill(epoch_counters_.begin(), epoch_counters_.end(), 0);
     for (auto& vec : vec_counters_) {
-        std::fill(vec.second.begin(), vec.second.end(), 0);
+        std::fill(vec.begin(), vec.end(), 0);
     }
     for (auto& vec : epoch_vec_counters_) {
-        std::fill(vec.second.begin(), vec.second.end(), 0);
+        std::fill(vec.begin(), vec.end(), 0);
     }
     for (auto& it : doubles_) {
         it.second = 0.0;
@@ -192,30 +298,34 @@ void SimpleStats::Reset() {
     for (auto& it : calculated_) {
         it.second = 0.0;
     }
-    for (auto& it : histo_counts_) {
-        it.second.clear();
+    for (auto& counts : histo_counts_) {
+        counts.clear();
     }
-    for (auto& it : epoch_histo_counts_) {
-        it.second.clear();
+    for (auto& counts : epoch_histo_counts_) {
+        counts.clear();
     }
 }
 
-void SimpleStats::InitStat(std::string name, std::string stat_type,
-                           std::string description) {
+StatId SimpleStats::InitStat(std::string name, std::string stat_type,
+                             std::string description) {
     header_descs_.emplace(name, description);
     if (stat_type == "counter") {
-        counters_.emplace(name, 0);
-        epoch_counters_.emplace(name, 0);
+        StatId id = counters_.size();
+        counter_ids_.emplace(name, id);
+        counters_.push_back(0);
+        epoch_counters_.push_back(0);
+        return id;
     } else if (stat_type == "double") {
         doubles_.emplace(name, 0.0);
     } else if (stat_type == "calculated") {
         calculated_.emplace(name, 0.0);
     }
+    return -1;
 }
 
-void SimpleStats::InitVecStat(std::string name, std::string stat_type,
-                              std::string description, std::string part_name,
-                              int vec_len) {
+StatId SimpleStats::InitVecStat(std::string name, std::string stat_type,
+                                std::string description, std::string part_name,
+                                int vec_len) {
     for (int i = 0; i < vec_len; i++) {
         std::string trailing = "." + std::to_string(i);
         std::string actual_name = name + trailing;
@@ -223,20 +333,26 @@ void SimpleStats::InitVecStat(std::string name, std::string stat_type,
         header_descs_.emplace(actual_name, actual_desc);
     }
     if (stat_type == "vec_counter") {
-        vec_counters_.emplace(name, std::vector<uint64_t>(vec_len, 0));
-        epoch_vec_counters_.emplace(name, std::vector<uint64_t>(vec_len, 0));
+        StatId id = vec_counters_.size();
+        vec_counter_ids_.emplace(name, id);
+        vec_counters_.emplace_back(vec_len, 0);
+        epoch_vec_counters_.emplace_back(vec_len, 0);
+        return id;
     } else if (stat_type == "vec_double") {
         vec_doubles_.emplace(name, std::vector<double>(vec_len, 0));
     }
+    return -1;
 }
 
-void SimpleStats::InitHistoStat(std::string name, std::string description,
-                                int start_val, int end_val, int num_bins) {
+StatId SimpleStats::InitHistoStat(std::string name, std::string description,
+                                  int start_val, int end_val, int num_bins) {
+    StatId id = histo_headers_.size();
+    histo_ids_.emplace(name, id);
     int bin_width = (end_val - start_val) / num_bins;
-    bin_widths_.emplace(name, bin_width);
-    histo_bounds_.emplace(name, std::make_pair(start_val, end_val));
-    histo_counts_.emplace(name, std::unordered_map<int, uint64_t>());
-    epoch_histo_counts_.emplace(name, std::unordered_map<int, uint64_t>());
+    bin_widths_.push_back(bin_width);
+    histo_bounds_.emplace_back(start_val, end_val);
+    histo_counts_.emplace_back();
+    epoch_histo_counts_.emplace_back();
 
     // initialize headers, descriptions
     std::vector<std::string> headers;
@@ -254,61 +370,54 @@ void SimpleStats::InitHistoStat(std::string name, std::string description,
     headers.push_back(header);
     header_descs_.emplace(header, description);
 
-    histo_headers_.emplace(name, headers);
+    histo_headers_.push_back(headers);
 
     // +2 for front and end
-    histo_bins_.emplace(name, std::vector<uint64_t>(num_bins + 2, 0));
-    epoch_histo_bins_.emplace(name, std::vector<uint64_t>(num_bins + 2, 0));
+    histo_bins_.emplace_back(num_bins + 2, 0);
+    epoch_histo_bins_.emplace_back(num_bins + 2, 0);
+    return id;
 }
 
 void SimpleStats::UpdateCounters() {
-    // std::cout << "[Hritvik] UpdateCounters" << std::endl;
-    for (const auto& it : epoch_counters_) {
-        counters_[it.first] += it.second;
+    for (size_t i = 0; i < counters_.size(); i++) {
+        counters_[i] += epoch_counters_[i];
     }
-    for (const auto& vec : epoch_vec_counters_) {
-        for (size_t i = 0; i < vec.second.size(); i++) {
-            vec_counters_[vec.first][i] += vec.second[i];
+    for (size_t i = 0; i < vec_counters_.size(); i++) {
+        for (size_t j = 0; j < vec_counters_[i].size(); j++) {
+            vec_counters_[i][j] += epoch_vec_counters_[i][j];
         }
     }
 }
 
 void SimpleStats::UpdateHistoBins() {
-    for (auto& name_bins : epoch_histo_bins_) {
-        const auto& name = name_bins.first;
-        auto& bins = name_bins.second;
+    for (size_t id = 0; id < epoch_histo_bins_.size(); id++) {
+        auto& bins = epoch_histo_bins_[id];
+        const auto& bounds = histo_bounds_[id];
         std::fill(bins.begin(), bins.end(), 0);
-        for (const auto it : epoch_histo_counts_[name]) {
+        for (const auto it : epoch_histo_counts_[id]) {
             int value = it.first;
             uint64_t count = it.second;
             int bin_idx = 0;
-            if (value < histo_bounds_[name].first) {
+            if (value < bounds.first) {
                 bin_idx = 0;
-            } else if (value > histo_bounds_[name].second) {
+            } else if (value > bounds.second) {
                 bin_idx = bins.size() - 1;
             } else {
-                bin_idx =
-                    (value - histo_bounds_[name].first) / bin_widths_[name] + 1;
+                bin_idx = (value - bounds.first) / bin_widths_[id] + 1;
             }
             bins[bin_idx] += count;
         }
     }
 
     // update overall histogram counts based on epoch histo counts
-    for (auto& name_counts : epoch_histo_counts_) {
-        const auto& name = name_counts.first;
-        auto& epoch_counts = name_counts.second;
-        auto& final_counts = histo_counts_[name];
-        for (const auto& val_cnt : epoch_counts) {
-            if (final_counts.count(val_cnt.first) <= 0) {
-                final_counts[val_cnt.first] = val_cnt.second;
-            } else {
-                final_counts[val_cnt.first] += val_cnt.second;
-            }
+    for (size_t id = 0; id < epoch_histo_counts_.size(); id++) {
+        auto& final_counts = histo_counts_[id];
+        for (const auto& val_cnt : epoch_histo_counts_[id]) {
+            final_counts[val_cnt.first] += val_cnt.second;
         }
-        auto& final_bins = histo_bins_[name];
+        auto& final_bins = histo_bins_[id];
         for (size_t i = 0; i < final_bins.size(); i++) {
-            final_bins[i] += epoch_histo_bins_[name][i];
+            final_bins[i] += epoch_histo_bins_[id][i];
         }
     }
 }
@@ -328,30 +437,33 @@ double SimpleStats::GetHistoAvg(const HistoCount& hist_counts) const {
 void SimpleStats::UpdatePrints(bool epoch) {
     j_data_["channel"] = channel_id_;
 
-    std::unordered_map<std::string, uint64_t>& ref_counters =
-        epoch ? epoch_counters_ : counters_;
-    for (const auto& it : ref_counters) {
-        print_pairs_.emplace_back(it.first, std::to_string(it.second));
-        j_data_[it.first] = it.second;
+    // name -> handle maps are iterated so the output order stays the same
+    std::vector<uint64_t>& ref_counters = epoch ? epoch_counters_ : counters_;
+    for (const auto& it : counter_ids_) {
+        uint64_t value = ref_counters[it.second];
+        print_pairs_.emplace_back(it.first, std::to_string(value));
+        j_data_[it.first] = value;
     }
-    j_data_["epoch_num"] = counters_["epoch_num"];
+    j_data_["epoch_num"] = counters_[GetCounterId("epoch_num")];
 
     VecStat& ref_vcounter = epoch ? epoch_vec_counters_ : vec_counters_;
-    for (const auto& it : ref_vcounter) {
+    for (const auto& it : vec_counter_ids_) {
+        const auto& vec = ref_vcounter[it.second];
         Json j_list;
-        for (size_t i = 0; i < it.second.size(); i++) {
+        for (size_t i = 0; i < vec.size(); i++) {
             std::string name = it.first + "." + std::to_string(i);
-            print_pairs_.emplace_back(name, std::to_string(it.second[i]));
-            j_list[std::to_string(i)] = it.second[i];
+            print_pairs_.emplace_back(name, std::to_string(vec[i]));
+            j_list[std::to_string(i)] = vec[i];
         }
         j_data_[it.first] = j_list;
     }
     VecStat& ref_hbins = epoch ? epoch_histo_bins_ : histo_bins_;
-    for (const auto& it : ref_hbins) {
-        const auto& names = histo_headers_[it.first];
-        for (size_t i = 0; i < it.second.size(); i++) {
-            print_pairs_.emplace_back(names[i], std::to_string(it.second[i]));
-            j_data_[names[i]] = it.second[i];
+    for (const auto& it : histo_ids_) {
+        const auto& names = histo_headers_[it.second];
+        const auto& bins = ref_hbins[it.second];
+        for (size_t i = 0; i < bins.size(); i++) {
+            print_pairs_.emplace_back(names[i], std::to_string(bins[i]));
+            j_data_[names[i]] = bins[i];
         }
     }
 
@@ -359,12 +471,12 @@ void SimpleStats::UpdatePrints(bool epoch) {
     // huge therefore we only put aggregated histo in each epoch but
     // complete data at the end
     if (!epoch) {
-        for (const auto& name_hist : histo_counts_) {
+        for (const auto& name_id : histo_ids_) {
             Json j_list;
-            for (const auto& it : name_hist.second) {
+            for (const auto& it : histo_counts_[name_id.second]) {
                 j_list[std::to_string(it.first)] = it.second;
             }
-            j_data_[name_hist.first] = j_list;
+            j_data_[name_id.first] = j_list;
         }
     }
 
@@ -394,25 +506,25 @@ void SimpleStats::UpdateEpochStats() {
 
     // update computed stats
     doubles_["act_energy"] =
-        epoch_counters_["num_act_cmds"] * config_.act_energy_inc;
+        epoch_counters_[GetCounterId("num_act_cmds")] * config_.act_energy_inc;
     doubles_["read_energy"] =
-        epoch_counters_["num_read_cmds"] * config_.read_energy_inc;
+        epoch_counters_[GetCounterId("num_read_cmds")] * config_.read_energy_inc;
     doubles_["write_energy"] =
-        epoch_counters_["num_write_cmds"] * config_.write_energy_inc;
+        epoch_counters_[GetCounterId("num_write_cmds")] * config_.write_energy_inc;
     doubles_["refab_energy"] =
-        epoch_counters_["num_refab_cmds"] * config_.ref_energy_inc;
+        epoch_counters_[GetCounterId("num_refab_cmds")] * config_.ref_energy_inc;
     doubles_["refb_energy"] =
-        epoch_counters_["num_refb_cmds"] * config_.refb_energy_inc;
+        epoch_counters_[GetCounterId("num_refb_cmds")] * config_.refb_energy_inc;
 
     // vector doubles, update first, then push
     double background_energy = 0.0;
     for (int i = 0; i < config_.ranks; i++) {
-        double act_stb = epoch_vec_counters_["rank_active_cycles"][i] *
+        double act_stb = epoch_vec_counters_[GetVecCounterId("rank_active_cycles")][i] *
                          config_.act_stb_energy_inc;
-        double pre_stb = epoch_vec_counters_["all_bank_idle_cycles"][i] *
+        double pre_stb = epoch_vec_counters_[GetVecCounterId("all_bank_idle_cycles")][i] *
                          config_.pre_stb_energy_inc;
         double sref_energy =
-            epoch_vec_counters_["sref_cycles"][i] * config_.sref_energy_inc;
+            epoch_vec_counters_[GetVecCounterId("sref_cycles")][i] * config_.sref_energy_inc;
         vec_doubles_["act_stb_energy"][i] = act_stb;
         vec_doubles_["pre_stb_energy"][i] = pre_stb;
         vec_doubles_["sref_energy"][i] = sref_energy;
@@ -423,8 +535,8 @@ void SimpleStats::UpdateEpochStats() {
 
     // calculated stats
     uint64_t total_reqs =
-        epoch_counters_["num_reads_done"] + epoch_counters_["num_writes_done"];
-    double total_time = epoch_counters_["num_cycles"] * config_.tCK;
+        epoch_counters_[GetCounterId("num_reads_done")] + epoch_counters_[GetCounterId("num_writes_done")];
+    double total_time = epoch_counters_[GetCounterId("num_cycles")] * config_.tCK;
     double avg_bw = total_reqs * config_.request_size_bytes / total_time;
     calculated_["average_bandwidth"] = avg_bw;
 
@@ -432,50 +544,50 @@ void SimpleStats::UpdateEpochStats() {
                           doubles_["write_energy"] + doubles_["ref_energy"] +
                           doubles_["refb_energy"] + background_energy;
     calculated_["total_energy"] = total_energy;
-    calculated_["average_power"] = total_energy / epoch_counters_["num_cycles"];
+    calculated_["average_power"] = total_energy / epoch_counters_[GetCounterId("num_cycles")];
     calculated_["average_read_latency"] =
-        GetHistoAvg(epoch_histo_counts_.at("read_latency"));
+        GetHistoAvg(epoch_histo_counts_[GetHistoId("read_latency")]);
     calculated_["average_interarrival"] =
-        GetHistoAvg(epoch_histo_counts_.at("interarrival_latency"));
+        GetHistoAvg(epoch_histo_counts_[GetHistoId("interarrival_latency")]);
 
-    calculated_["mean_t_btwn_write_drains"] = GetHistoAvg(epoch_histo_counts_.at("t_btwn_write_drains"));
-    calculated_["mean_t_btwn_opp_write_drains"] = GetHistoAvg(epoch_histo_counts_.at("t_btwn_opp_write_drains"));
+    calculated_["mean_t_btwn_write_drains"] = GetHistoAvg(epoch_histo_counts_[GetHistoId("t_btwn_write_drains")]);
+    calculated_["mean_t_btwn_opp_write_drains"] = GetHistoAvg(epoch_histo_counts_[GetHistoId("t_btwn_opp_write_drains")]);
 
-    UpdatePrints(true);
-    for (auto& it : epoch_counters_) {
-        it.second = 0;
-    }
+    return;
+}
+
+void SimpleStats::ClearEpochStats() {
+    std::fill(epoch_counters_.begin(), epoch_counters_.end(), 0);
     for (auto& vec : epoch_vec_counters_) {
-        std::fill(vec.second.begin(), vec.second.end(), 0);
+        std::fill(vec.begin(), vec.end(), 0);
     }
-    for (auto& it : epoch_histo_counts_) {
-        it.second.clear();
+    for (auto& counts : epoch_histo_counts_) {
+        counts.clear();
     }
-    return;
 }
 
 void SimpleStats::UpdateFinalStats() {
     UpdateCounters();
 
     // update computed stats
-    doubles_["act_energy"] = counters_["num_act_cmds"] * config_.act_energy_inc;
+    doubles_["act_energy"] = counters_[GetCounterId("num_act_cmds")] * config_.act_energy_inc;
     doubles_["read_energy"] =
-        counters_["num_read_cmds"] * config_.read_energy_inc;
+        counters_[GetCounterId("num_read_cmds")] * config_.read_energy_inc;
     doubles_["write_energy"] =
-        counters_["num_write_cmds"] * config_.write_energy_inc;
-    doubles_["refab_energy"] = counters_["num_refab_cmds"] * config_.ref_energy_inc;
+        counters_[GetCounterId("num_write_cmds")] * config_.write_energy_inc;
+    doubles_["refab_energy"] = counters_[GetCounterId("num_refab_cmds")] * config_.ref_energy_inc;
     doubles_["refb_energy"] =
-        counters_["num_refb_cmds"] * config_.refb_energy_inc;
+        counters_[GetCounterId("num_refb_cmds")] * config_.refb_energy_inc;
 
     // vector doubles, update first, then push
     double background_energy = 0.0;
     for (int i = 0; i < config_.ranks; i++) {
         double act_stb =
-            vec_counters_["rank_active_cycles"][i] * config_.act_stb_energy_inc;
-        double pre_stb = vec_counters_["all_bank_idle_cycles"][i] *
+            vec_counters_[GetVecCounterId("rank_active_cycles")][i] * config_.act_stb_energy_inc;
+        double pre_stb = vec_counters_[GetVecCounterId("all_bank_idle_cycles")][i] *
                          config_.pre_stb_energy_inc;
         double sref_energy =
-            vec_counters_["sref_cycles"][i] * config_.sref_energy_inc;
+            vec_counters_[GetVecCounterId("sref_cycles")][i] * config_.sref_energy_inc;
         vec_doubles_["act_stb_energy"][i] = act_stb;
         vec_doubles_["pre_stb_energy"][i] = pre_stb;
         vec_doubles_["sref_energy"][i] = sref_energy;
@@ -487,8 +599,8 @@ void SimpleStats::UpdateFinalStats() {
 
     // calculated stats
     uint64_t total_reqs =
-        counters_["num_reads_done"] + counters_["num_writes_done"];
-    double total_time = counters_["num_cycles"] * config_.tCK;
+        counters_[GetCounterId("num_reads_done")] + counters_[GetCounterId("num_writes_done")];
+    double total_time = counters_[GetCounterId("num_cycles")] * config_.tCK;
     double avg_bw = total_reqs * config_.request_size_bytes / total_time;
     calculated_["average_bandwidth"] = avg_bw;
 
@@ -496,15 +608,15 @@ void SimpleStats::UpdateFinalStats() {
                           doubles_["write_energy"] + doubles_["ref_energy"] +
                           doubles_["refb_energy"] + background_energy;
     calculated_["total_energy"] = total_energy;
-    calculated_["average_power"] = total_energy / counters_["num_cycles"];
+    calculated_["average_power"] = total_energy / counters_[GetCounterId("num_cycles")];
     // calculated_["average_read_latency"] = GetHistoAvg("read_latency");
     calculated_["average_read_latency"] =
-        GetHistoAvg(histo_counts_.at("read_latency"));
+        GetHistoAvg(histo_counts_[GetHistoId("read_latency")]);
     calculated_["average_interarrival"] =
-        GetHistoAvg(histo_counts_.at("interarrival_latency"));
+        GetHistoAvg(histo_counts_[GetHistoId("interarrival_latency")]);
 
-    calculated_["mean_t_btwn_write_drains"] = GetHistoAvg(epoch_histo_counts_.at("t_btwn_write_drains"));
-    calculated_["mean_t_btwn_opp_write_drains"] = GetHistoAvg(epoch_histo_counts_.at("t_btwn_opp_write_drains"));
+    calculated_["mean_t_btwn_write_drains"] = GetHistoAvg(epoch_histo_counts_[GetHistoId("t_btwn_write_drains")]);
+    calculated_["mean_t_btwn_opp_write_drains"] = GetHistoAvg(epoch_histo_counts_[GetHistoId("t_btwn_opp_write_drains")]);
 
     UpdatePrints(false);
     return;
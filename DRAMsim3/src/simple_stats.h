@@ -7,37 +7,62 @@
 #include <vector>
 
 #include "configuration.h"
+#include "epoch_writer.h"
 #include "json.hpp"
 
 namespace dramsim3 {
 
+// Dense handle to a stat. Names are resolved to handles once (at Init*Stat
+// or through Get*Id), so hot-path updates are plain array increments.
+using StatId = int;
+
 class SimpleStats {
    public:
     SimpleStats(const Config& config, int channel_id);
     // incrementing counter
-    void Increment(const std::string name) { epoch_counters_[name] += 1; }
+    void Increment(StatId id) { epoch_counters_[id] += 1; }
+    void Increment(const std::string& name) { Increment(GetCounterId(name)); }
+    void IncrementBy(StatId id, uint64_t num) { epoch_counters_[id] += num; }
 
-    uint64_t GetCtr(const std::string name) { return counters_[name]; }
-    uint64_t GetECtr(const std::string name) { return epoch_counters_[name]; }
+    uint64_t GetCtr(const std::string& name) const {
+        return counters_[GetCounterId(name)];
+    }
+    uint64_t GetECtr(const std::string& name) const {
+        return epoch_counters_[GetCounterId(name)];
+    }
 
     // incrementing for vec counter
-    void IncrementVec(const std::string name, int pos) {
-        epoch_vec_counters_[name][pos] += 1;
+    void IncrementVec(StatId id, int pos) { epoch_vec_counters_[id][pos] += 1; }
+    void IncrementVec(const std::string& name, int pos) {
+        IncrementVec(GetVecCounterId(name), pos);
     }
 
     // increment vec counter by number
-    void IncrementVecBy(const std::string name, int pos, int num) {
-        epoch_vec_counters_[name][pos] += num;
+    void IncrementVecBy(StatId id, int pos, uint64_t num) {
+        epoch_vec_counters_[id][pos] += num;
+    }
+    void IncrementVecBy(const std::string& name, int pos, uint64_t num) {
+        IncrementVecBy(GetVecCounterId(name), pos, num);
     }
 
     // add historgram value
-    void AddValue(const std::string name, const int value);
+    void AddValue(StatId id, const int value) {
+        epoch_histo_counts_[id][value] += 1;
+    }
+    void AddValue(const std::string& name, const int value) {
+        AddValue(GetHistoId(name), value);
+    }
+
+    // name -> handle lookups (exit if the stat was never initialized)
+    StatId GetCounterId(const std::string& name) const;
+    StatId GetVecCounterId(const std::string& name) const;
+    StatId GetHistoId(const std::string& name) const;
 
     // return per rank background energy
     double RankBackgroundEnergy(const int r) const;
 
     // Epoch update
-    void PrintEpochStats();
+    void PrintEpochStats(EpochWriter& writer);
 
     // Final statas output
     void PrintFinalStats(bool stdout);
@@ -45,16 +70,19 @@ class SimpleStats {
     // Reset (usually after one phase of simulation)
     void Reset();
 
-    using VecStat = std::unordered_map<std::string, std::vector<uint64_t> >;
+    using VecStat = std::vector<std::vector<uint64_t> >;
     using HistoCount = std::unordered_map<int, uint64_t>;
+    using StatIdMap = std::unordered_map<std::string, StatId>;
     using Json = nlohmann::json;
-    void InitStat(std::string name, std::string stat_type,
-                  std::string description);
-    void InitVecStat(std::string name, std::string stat_type,
-                     std::string description, std::string part_name,
-                     int vec_len);
-    void InitHistoStat(std::string name, std::string description, int start_val,
-                       int end_val, int num_bins);
+    // These return the new stat's handle (or -1 for double/calculated stats,
+    // which are only updated by SimpleStats itself).
+    StatId InitStat(std::string name, std::string stat_type,
+                    std::string description);
+    StatId InitVecStat(std::string name, std::string stat_type,
+                       std::string description, std::string part_name,
+                       int vec_len);
+    StatId InitHistoStat(std::string name, std::string description,
+                         int start_val, int end_val, int num_bins);
    private:
     void UpdateCounters();
     void UpdateHistoBins();
@@ -62,7 +90,11 @@ class SimpleStats {
     double GetHistoAvg(const HistoCount& histo_counts) const;
     std::string GetTextHeader(bool is_final) const;
     void UpdateEpochStats();
+    void ClearEpochStats();
     void UpdateFinalStats();
+    // epoch record for a columnar EpochWriter, same content as UpdatePrints
+    void WriteEpochColumns(std::ostream& out);
+    void WriteEpochRow(std::ostream& out, bool names) const;
 
     const Config& config_;
     int channel_id_;
@@ -70,11 +102,13 @@ class SimpleStats {
     // map names to descriptions
     std::unordered_map<std::string, std::string> header_descs_;
 
-    // counter stats, indexed by their name
-    std::unordered_map<std::string, uint64_t> counters_;
-    std::unordered_map<std::string, uint64_t> epoch_counters_;
+    // counter stats, indexed by the handles in counter_ids_
+    StatIdMap counter_ids_;
+    std::vector<uint64_t> counters_;
+    std::vector<uint64_t> epoch_counters_;
 
-    // vectored counter stats, first indexed by name then by index
+    // vectored counter stats, first indexed by handle then by index
+    StatIdMap vec_counter_ids_;
     VecStat vec_counters_;
     VecStat epoch_vec_counters_;
 
@@ -88,17 +122,19 @@ class SimpleStats {
     // calculated stats, similar to double, but not the same
     std::unordered_map<std::string, double> calculated_;
 
-    // histogram stats
-    std::unordered_map<std::string, std::vector<std::string> > histo_headers_;
+    // histogram stats, indexed by the handles in histo_ids_
+    StatIdMap histo_ids_;
+    std::vector<std::vector<std::string> > histo_headers_;
 
-    std::unordered_map<std::string, std::pair<int, int> > histo_bounds_;
-    std::unordered_map<std::string, int> bin_widths_;
-    std::unordered_map<std::string, HistoCount> histo_counts_;
-    std::unordered_map<std::string, HistoCount> epoch_histo_counts_;
+    std::vector<std::pair<int, int> > histo_bounds_;
+    std::vector<int> bin_widths_;
+    std::vector<HistoCount> histo_counts_;
+    std::vector<HistoCount> epoch_histo_counts_;
     VecStat histo_bins_;
     VecStat epoch_histo_bins_;
 
     // outputs
+    bool epoch_schema_written_;
     Json j_data_;
     std::vector<std::pair<std::string, std::string> > print_pairs_;
 };
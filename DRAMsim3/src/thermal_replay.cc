@@ -8,6 +8,7 @@ ThermalReplay::ThermalReplay(std::string trace_name, std::string config_file,
                              std::string output_dir, uint64_t repeat)
     : config_(config_file, output_dir),
       thermal_calc_(config_),
+      epoch_writer_(config_),
       repeat_(repeat),
       last_clk_(0) {
     for (int i = 0; i < config_.channels; i++) {
@@ -76,7 +77,7 @@ void ThermalReplay::Run() {
     }
     for (int c = 0; c < config_.channels; c++) {
         //channel_stats_[c].PrintFinalStats(clk, std::cout, std::cout, std::cout);
-        channel_stats_[c].PrintFinalStats();
+        channel_stats_[c].PrintFinalStats(false);
     }
     thermal_calc_.PrintFinalPT(clk);
 }
@@ -153,7 +154,7 @@ void ThermalReplay::ProcessCMD(Command &cmd, uint64_t clk) {
             channel_stats_[channel].Increment("num_pre_cmds");
             break;
         case CommandType::REFab:
-            channel_stats_[channel].Increment("num_ref_cmds");
+            channel_stats_[channel].Increment("num_refab_cmds");
             break;
         case CommandType::REFRESH_BANK:
             channel_stats_[channel].Increment("num_refb_cmds");
@@ -188,7 +189,7 @@ void ThermalReplay::ProcessCMD(Command &cmd, uint64_t clk) {
         for (int c = 0; c < config_.channels; c++) {
             // where to print isn't important here what we really need is the
             // updated stats
-            channel_stats_[c].PrintEpochStats();
+            channel_stats_[c].PrintEpochStats(epoch_writer_);
             for (int r = 0; r < config_.ranks; r++) {
                 double bg_energy = channel_stats_[c].RankBackgroundEnergy(r);
                 thermal_calc_.UpdateBackgroundEnergy(c, r, bg_energy);
@@ -23,6 +23,7 @@ class ThermalReplay {
     std::vector<std::pair<uint64_t, Command>> timed_commands_;
     Config config_;
     ThermalCalculator thermal_calc_;
+    EpochWriter epoch_writer_;
     uint64_t repeat_;
     uint64_t last_clk_;
     std::vector<SimpleStats> channel_stats_;
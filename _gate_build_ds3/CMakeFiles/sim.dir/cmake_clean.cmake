@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sim.dir/main/sim.cpp.o"
+  "CMakeFiles/sim.dir/main/sim.cpp.o.d"
+  "sim"
+  "sim.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sim.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
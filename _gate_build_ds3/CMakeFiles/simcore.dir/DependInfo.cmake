@@ -0,0 +1,33 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/cache/controller/llc2.cpp" "CMakeFiles/simcore.dir/src/cache/controller/llc2.cpp.o" "gcc" "CMakeFiles/simcore.dir/src/cache/controller/llc2.cpp.o.d"
+  "/root/repo/src/cache/replacement.cpp" "CMakeFiles/simcore.dir/src/cache/replacement.cpp.o" "gcc" "CMakeFiles/simcore.dir/src/cache/replacement.cpp.o.d"
+  "/root/repo/src/core.cpp" "CMakeFiles/simcore.dir/src/core.cpp.o" "gcc" "CMakeFiles/simcore.dir/src/core.cpp.o.d"
+  "/root/repo/src/ds3/interface.cpp" "CMakeFiles/simcore.dir/src/ds3/interface.cpp.o" "gcc" "CMakeFiles/simcore.dir/src/ds3/interface.cpp.o.d"
+  "/root/repo/src/mmu.cpp" "CMakeFiles/simcore.dir/src/mmu.cpp.o" "gcc" "CMakeFiles/simcore.dir/src/mmu.cpp.o.d"
+  "/root/repo/src/os.cpp" "CMakeFiles/simcore.dir/src/os.cpp.o" "gcc" "CMakeFiles/simcore.dir/src/os.cpp.o.d"
+  "/root/repo/src/os/binned_allocator.cpp" "CMakeFiles/simcore.dir/src/os/binned_allocator.cpp.o" "gcc" "CMakeFiles/simcore.dir/src/os/binned_allocator.cpp.o.d"
+  "/root/repo/src/os/buddy_allocator.cpp" "CMakeFiles/simcore.dir/src/os/buddy_allocator.cpp.o" "gcc" "CMakeFiles/simcore.dir/src/os/buddy_allocator.cpp.o.d"
+  "/root/repo/src/os/frame_allocator.cpp" "CMakeFiles/simcore.dir/src/os/frame_allocator.cpp.o" "gcc" "CMakeFiles/simcore.dir/src/os/frame_allocator.cpp.o.d"
+  "/root/repo/src/os/page_data.cpp" "CMakeFiles/simcore.dir/src/os/page_data.cpp.o" "gcc" "CMakeFiles/simcore.dir/src/os/page_data.cpp.o.d"
+  "/root/repo/src/os/process.cpp" "CMakeFiles/simcore.dir/src/os/process.cpp.o" "gcc" "CMakeFiles/simcore.dir/src/os/process.cpp.o.d"
+  "/root/repo/src/os/random_allocator.cpp" "CMakeFiles/simcore.dir/src/os/random_allocator.cpp.o" "gcc" "CMakeFiles/simcore.dir/src/os/random_allocator.cpp.o.d"
+  "/root/repo/src/os/reverse_map.cpp" "CMakeFiles/simcore.dir/src/os/reverse_map.cpp.o" "gcc" "CMakeFiles/simcore.dir/src/os/reverse_map.cpp.o.d"
+  "/root/repo/src/os/tiering.cpp" "CMakeFiles/simcore.dir/src/os/tiering.cpp.o" "gcc" "CMakeFiles/simcore.dir/src/os/tiering.cpp.o.d"
+  "/root/repo/src/utils/argparse.cpp" "CMakeFiles/simcore.dir/src/utils/argparse.cpp.o" "gcc" "CMakeFiles/simcore.dir/src/utils/argparse.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,37 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/simcore.dir/src/cache/controller/llc2.cpp.o"
+  "CMakeFiles/simcore.dir/src/cache/controller/llc2.cpp.o.d"
+  "CMakeFiles/simcore.dir/src/cache/replacement.cpp.o"
+  "CMakeFiles/simcore.dir/src/cache/replacement.cpp.o.d"
+  "CMakeFiles/simcore.dir/src/core.cpp.o"
+  "CMakeFiles/simcore.dir/src/core.cpp.o.d"
+  "CMakeFiles/simcore.dir/src/ds3/interface.cpp.o"
+  "CMakeFiles/simcore.dir/src/ds3/interface.cpp.o.d"
+  "CMakeFiles/simcore.dir/src/mmu.cpp.o"
+  "CMakeFiles/simcore.dir/src/mmu.cpp.o.d"
+  "CMakeFiles/simcore.dir/src/os.cpp.o"
+  "CMakeFiles/simcore.dir/src/os.cpp.o.d"
+  "CMakeFiles/simcore.dir/src/os/binned_allocator.cpp.o"
+  "CMakeFiles/simcore.dir/src/os/binned_allocator.cpp.o.d"
+  "CMakeFiles/simcore.dir/src/os/buddy_allocator.cpp.o"
+  "CMakeFiles/simcore.dir/src/os/buddy_allocator.cpp.o.d"
+  "CMakeFiles/simcore.dir/src/os/frame_allocator.cpp.o"
+  "CMakeFiles/simcore.dir/src/os/frame_allocator.cpp.o.d"
+  "CMakeFiles/simcore.dir/src/os/page_data.cpp.o"
+  "CMakeFiles/simcore.dir/src/os/page_data.cpp.o.d"
+  "CMakeFiles/simcore.dir/src/os/process.cpp.o"
+  "CMakeFiles/simcore.dir/src/os/process.cpp.o.d"
+  "CMakeFiles/simcore.dir/src/os/random_allocator.cpp.o"
+  "CMakeFiles/simcore.dir/src/os/random_allocator.cpp.o.d"
+  "CMakeFiles/simcore.dir/src/os/reverse_map.cpp.o"
+  "CMakeFiles/simcore.dir/src/os/reverse_map.cpp.o.d"
+  "CMakeFiles/simcore.dir/src/os/tiering.cpp.o"
+  "CMakeFiles/simcore.dir/src/os/tiering.cpp.o.d"
+  "CMakeFiles/simcore.dir/src/utils/argparse.cpp.o"
+  "CMakeFiles/simcore.dir/src/utils/argparse.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/simcore.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
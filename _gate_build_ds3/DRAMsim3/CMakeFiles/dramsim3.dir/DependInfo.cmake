@@ -0,0 +1,33 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/DRAMsim3/src/bankstate.cc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/bankstate.cc.o" "gcc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/bankstate.cc.o.d"
+  "/root/repo/DRAMsim3/src/channel_state.cc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/channel_state.cc.o" "gcc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/channel_state.cc.o.d"
+  "/root/repo/DRAMsim3/src/command_queue.cc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/command_queue.cc.o" "gcc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/command_queue.cc.o.d"
+  "/root/repo/DRAMsim3/src/common.cc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/common.cc.o" "gcc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/common.cc.o.d"
+  "/root/repo/DRAMsim3/src/configuration.cc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/configuration.cc.o" "gcc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/configuration.cc.o.d"
+  "/root/repo/DRAMsim3/src/controller.cc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/controller.cc.o" "gcc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/controller.cc.o.d"
+  "/root/repo/DRAMsim3/src/dram_system.cc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/dram_system.cc.o" "gcc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/dram_system.cc.o.d"
+  "/root/repo/DRAMsim3/src/epoch_writer.cc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/epoch_writer.cc.o" "gcc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/epoch_writer.cc.o.d"
+  "/root/repo/DRAMsim3/src/hmc.cc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/hmc.cc.o" "gcc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/hmc.cc.o.d"
+  "/root/repo/DRAMsim3/src/memory_system.cc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/memory_system.cc.o" "gcc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/memory_system.cc.o.d"
+  "/root/repo/DRAMsim3/src/mitigation_queue.cc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/mitigation_queue.cc.o" "gcc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/mitigation_queue.cc.o.d"
+  "/root/repo/DRAMsim3/src/prac_counters.cc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/prac_counters.cc.o" "gcc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/prac_counters.cc.o.d"
+  "/root/repo/DRAMsim3/src/refresh.cc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/refresh.cc.o" "gcc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/refresh.cc.o.d"
+  "/root/repo/DRAMsim3/src/simple_stats.cc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/simple_stats.cc.o" "gcc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/simple_stats.cc.o.d"
+  "/root/repo/DRAMsim3/src/timing.cc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/timing.cc.o" "gcc" "DRAMsim3/CMakeFiles/dramsim3.dir/src/timing.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
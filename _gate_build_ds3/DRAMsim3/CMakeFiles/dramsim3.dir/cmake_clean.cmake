@@ -0,0 +1,39 @@
+file(REMOVE_RECURSE
+  "/root/repo/DRAMsim3/libdramsim3.pdb"
+  "/root/repo/DRAMsim3/libdramsim3.so"
+  "CMakeFiles/dramsim3.dir/src/bankstate.cc.o"
+  "CMakeFiles/dramsim3.dir/src/bankstate.cc.o.d"
+  "CMakeFiles/dramsim3.dir/src/channel_state.cc.o"
+  "CMakeFiles/dramsim3.dir/src/channel_state.cc.o.d"
+  "CMakeFiles/dramsim3.dir/src/command_queue.cc.o"
+  "CMakeFiles/dramsim3.dir/src/command_queue.cc.o.d"
+  "CMakeFiles/dramsim3.dir/src/common.cc.o"
+  "CMakeFiles/dramsim3.dir/src/common.cc.o.d"
+  "CMakeFiles/dramsim3.dir/src/configuration.cc.o"
+  "CMakeFiles/dramsim3.dir/src/configuration.cc.o.d"
+  "CMakeFiles/dramsim3.dir/src/controller.cc.o"
+  "CMakeFiles/dramsim3.dir/src/controller.cc.o.d"
+  "CMakeFiles/dramsim3.dir/src/dram_system.cc.o"
+  "CMakeFiles/dramsim3.dir/src/dram_system.cc.o.d"
+  "CMakeFiles/dramsim3.dir/src/epoch_writer.cc.o"
+  "CMakeFiles/dramsim3.dir/src/epoch_writer.cc.o.d"
+  "CMakeFiles/dramsim3.dir/src/hmc.cc.o"
+  "CMakeFiles/dramsim3.dir/src/hmc.cc.o.d"
+  "CMakeFiles/dramsim3.dir/src/memory_system.cc.o"
+  "CMakeFiles/dramsim3.dir/src/memory_system.cc.o.d"
+  "CMakeFiles/dramsim3.dir/src/mitigation_queue.cc.o"
+  "CMakeFiles/dramsim3.dir/src/mitigation_queue.cc.o.d"
+  "CMakeFiles/dramsim3.dir/src/prac_counters.cc.o"
+  "CMakeFiles/dramsim3.dir/src/prac_counters.cc.o.d"
+  "CMakeFiles/dramsim3.dir/src/refresh.cc.o"
+  "CMakeFiles/dramsim3.dir/src/refresh.cc.o.d"
+  "CMakeFiles/dramsim3.dir/src/simple_stats.cc.o"
+  "CMakeFiles/dramsim3.dir/src/simple_stats.cc.o.d"
+  "CMakeFiles/dramsim3.dir/src/timing.cc.o"
+  "CMakeFiles/dramsim3.dir/src/timing.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/dramsim3.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
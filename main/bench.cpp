@@ -0,0 +1,520 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#include <defs.h>
+
+#include <cache.h>
+#include <cache/controller.h>
+#include <cache/controller/llc2.h>
+#include <core.h>
+#include <mmu.h>
+#include <os.h>
+#include <os/process.h>
+
+#ifdef USE_DRAMSIM3
+#include <ds3/interface.h>
+#else
+#include <dram/controller.h>
+#include <dram/config.h>
+#include <dram/rank.h>
+#endif
+
+#include <utils/argparse.h>
+#include <utils/timer.h>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include <string.h>
+#include <unistd.h>
+#include <zlib.h>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * Microbenchmarks of the simulator's hot paths (after a few sanity checks,
+ * see `run_checks`). Each one prints its best
+ * ns/op over `REPS` timed runs as a stat line, so the output of one run can
+ * be passed back as `-baseline` to flag per-component regressions:
+ *
+ *      ./sim_bench > base.txt
+ *      ./sim_bench -baseline base.txt -tolerance 10
+ *
+ * The globals are set up as in `main/sim.cpp` (default configuration).
+ * */
+
+constexpr uint64_t  SEED = 12345678;
+constexpr uint64_t  DRAM_SIZE_MB = CHANNEL_SIZE_MB * NUM_CHANNELS;
+constexpr size_t    REPS = 3;
+/*
+ * Address streams are precomputed (so the RNG is not timed) and reused
+ * modulo their size.
+ * */
+constexpr size_t    STREAM_SIZE = 1 << 20;
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+uint64_t    GL_cycle_ = 0;
+
+OS*             GL_os_;
+Core*           GL_cores_[N_THREADS];
+LLC2Controller* GL_llc_controller_;
+
+#ifdef USE_DRAMSIM3
+DS3Interface*   GL_memory_controller_;
+#else
+DRAMController* GL_memory_controller_;
+DRAMConfig      GL_dram_conf_;
+#endif
+
+std::mt19937_64 GL_RNG_(SEED);
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+std::string OPT_filter_;
+uint64_t    OPT_ops_;
+std::string OPT_baseline_;
+double      OPT_tolerance_;
+std::string OPT_ds3_cfg_;
+
+std::vector<std::pair<std::string, double>> results_;
+/*
+ * Results are accumulated here so that the benchmarked calls are not
+ * optimized away.
+ * */
+volatile uint64_t sink_;
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+bool
+is_selected(std::string name) {
+    return OPT_filter_ == "all" || name.find(OPT_filter_) != std::string::npos;
+}
+/*
+ * Times `ops` calls of `f(i)` (after `ops/10` warm-up calls) and records the
+ * best ns/op over `REPS` runs. `i` keeps counting across runs.
+ * */
+void
+bench(std::string name, uint64_t ops, const std::function<uint64_t(uint64_t)>& f) {
+    if (!is_selected(name)) {
+        return;
+    }
+    uint64_t i = 0,
+             acc = 0;
+    for (uint64_t k = 0; k < ops/10; k++) {
+        acc += f(i++);
+    }
+    double best = 0.0;
+    Timer tt;
+    for (size_t r = 0; r < REPS; r++) {
+        tt.start();
+        for (uint64_t k = 0; k < ops; k++) {
+            acc += f(i++);
+        }
+        double ns_per_op = ((double)tt.end()) / ((double)ops);
+        if (r == 0 || ns_per_op < best) {
+            best = ns_per_op;
+        }
+    }
+    sink_ = acc;
+    results_.emplace_back(name, best);
+    PRINT_STAT(std::cout, name, best);
+    std::cout.flush();
+}
+
+std::vector<uint64_t>
+make_stream(uint64_t universe) {
+    std::vector<uint64_t> s(STREAM_SIZE);
+    for (uint64_t& x : s) {
+        x = GL_RNG_() % universe;
+    }
+    return s;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * `Cache::probe` and `Cache::fill` under each replacement policy. Probes hit
+ * about half the time (the footprint is twice the capacity); every fill of a
+ * new line evicts one.
+ * */
+template <CacheReplPolicy POL>
+void
+bench_cache(std::string policy) {
+    using C = Cache<LLC_SIZE_KB, LLC_ASSOC, POL>;
+    constexpr uint64_t LINES = C::SETS*LLC_ASSOC;
+
+    C* c = new C;
+    auto stream = make_stream(2*LINES);
+    uint64_t vic;
+    for (uint64_t i = 0; i < LINES; i++) {
+        c->fill(stream[i], 0, vic);
+    }
+    bench("CACHE_PROBE_" + policy, OPT_ops_,
+            [&] (uint64_t i) { return c->probe(stream[i % STREAM_SIZE]); });
+    bench("CACHE_FILL_" + policy, OPT_ops_,
+            [&] (uint64_t i)
+            {
+                uint64_t v = 0;
+                c->fill(stream[i % STREAM_SIZE] + 2*LINES, 0, v);
+                return v;
+            });
+    delete c;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * `CacheController` with a next level that always accepts and a previous
+ * level that ignores completions, so only the controller itself is timed.
+ * */
+class BenchController : public CacheController<BenchController, LLC> {
+public:
+    constexpr static size_t             MSHR_SIZE = 512;
+    constexpr static uint64_t           CACHE_LATENCY = 24;
+    constexpr static std::string_view   CACHE_NAME = "BENCH";
+    constexpr static CacheHitPolicy     CACHE_HIT_POLICY = CacheHitPolicy::DEFAULT;
+
+    void update_prev_level(uint64_t, size_t, size_t, uint64_t) {}
+    int  access_next_level(uint64_t, size_t, size_t, uint64_t, bool) { return 1; }
+    void _tick(void) {}
+    void _print_stats(std::ostream&) {}
+};
+
+void
+bench_cache_controller() {
+    constexpr uint64_t LINES = LLC::SETS*LLC_ASSOC;
+
+    BenchController* ctrl = new BenchController;
+    auto stream = make_stream(LINES/2);
+    for (uint64_t i = 0; i < LINES/2; i++) {
+        ctrl->access(i, 0, 0, 0, false);
+    }
+    bench("CTRL_ACCESS_HIT", OPT_ops_,
+            [&] (uint64_t i) { return ctrl->access(stream[i % STREAM_SIZE], 0, 0, i, true); });
+    // A load miss followed by its fill, to a line never seen before.
+    bench("CTRL_ACCESS_MISS_AND_FINISH", OPT_ops_,
+            [&] (uint64_t i)
+            {
+                uint64_t x = LINES + i;
+                int r = ctrl->access(x, 0, 0, i, true);
+                ctrl->mark_as_finished(x);
+                return static_cast<uint64_t>(r);
+            });
+    delete ctrl;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * `OS::v2p`: a translation cache hit, a translation cache miss on a mapped
+ * page (all pages share one translation cache entry), and a page fault.
+ * */
+void
+bench_os() {
+    constexpr uint64_t MAPPED_PAGES = 4096;
+    constexpr uint64_t FAULT_BASE_VPN = 1ULL << 32;
+
+    for (uint64_t k = 0; k < MAPPED_PAGES; k++) {
+        GL_os_->v2p(join_page_and_offset(k*OS_TC_ENTRIES, 0), 0);
+    }
+    bench("OS_V2P_TC_HIT", OPT_ops_,
+            [&] (uint64_t i) { return GL_os_->v2p(i % LINES_PER_PAGE, 0); });
+    bench("OS_V2P_TC_MISS", OPT_ops_,
+            [&] (uint64_t i)
+            {
+                uint64_t vpn = (i % MAPPED_PAGES)*OS_TC_ENTRIES;
+                return GL_os_->v2p(join_page_and_offset(vpn, 0), 0);
+            });
+    // Every fault takes a frame: keep the footprint well below DRAM.
+    bench("OS_V2P_FAULT", OPT_ops_/4,
+            [&] (uint64_t i) { return GL_os_->v2p(join_page_and_offset(FAULT_BASE_VPN+i, 0), 0); });
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * `Process::read_next_inst` on a synthetic trace (a load every 4
+ * instructions, every 8th access a write), in the format this build reads.
+ * */
+void
+write_trace(std::string path, uint64_t n) {
+    gzFile out = gzopen(path.c_str(), "w1");
+    uint64_t num = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        num += 4;
+        uint64_t va = (GL_RNG_() % (1ULL << 30)) & ~(LINESIZE-1);
+#ifdef COMPRESSION_TRACES
+        uint8_t skip = 0,
+                has_wb = (i % 8 == 0);
+        char linedata[64] = {};
+        gzwrite(out, &num, 8);
+        gzwrite(out, &skip, 1);
+        gzwrite(out, &va, 8);
+        gzwrite(out, &has_wb, 1);
+        if (has_wb) {
+            memcpy(linedata, &i, 8);
+            gzwrite(out, &va, 8);
+            gzwrite(out, linedata, 64);
+        }
+#else
+        uint8_t is_wb = (i % 8 == 0);
+        uint64_t vla = va >> Log2<LINESIZE>::value;
+        gzwrite(out, &num, 5);
+        gzwrite(out, &is_wb, 1);
+        gzwrite(out, &vla, 4);
+#endif
+    }
+    gzclose(out);
+}
+
+void
+bench_trace() {
+    if (!is_selected("TRACE_READ_NEXT_INST")) {
+        return;
+    }
+    std::string path = "/tmp/sim_bench_" + std::to_string(getpid()) + ".gz";
+    write_trace(path, 1 << 18);
+    Process* p = new Process(0, 0, path);
+    bench("TRACE_READ_NEXT_INST", OPT_ops_,
+            [&] (uint64_t i)
+            {
+                p->read_next_inst();
+                return p->next_inst_.vla;
+            });
+    delete p;
+    unlink(path.c_str());
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * A memory controller tick with no requests, and with new random reads
+ * offered every cycle (the queues stay full). Completions go to the LLC.
+ * */
+void
+bench_memory() {
+    constexpr uint64_t DRAM_LINES = (DRAM_SIZE_MB << 20) / LINESIZE;
+    auto stream = make_stream(DRAM_LINES);
+
+#ifdef USE_DRAMSIM3
+    auto tick = [] () { GL_memory_controller_->mem_->ClockTick(); };
+    std::string name = "DS3_CLOCK_TICK";
+#else
+    auto tick = [] () { GL_memory_controller_->tick(); };
+    std::string name = "DRAM_CTRL_TICK";
+#endif
+    bench(name + "_IDLE", OPT_ops_,
+            [&] (uint64_t i)
+            {
+                tick();
+                ++GL_cycle_;
+                return 0;
+            });
+    // Saturated ticks and rank selection take microseconds: fewer ops.
+    bench(name + "_SATURATED", OPT_ops_/100,
+            [&] (uint64_t i)
+            {
+                GL_memory_controller_->make_request(stream[i % STREAM_SIZE], true);
+                tick();
+                ++GL_cycle_;
+                return 0;
+            });
+}
+
+#ifndef USE_DRAMSIM3
+/*
+ * `DRAMRank::select_command` with `depth` commands in every bank's queue.
+ * The selected command is executed and a finished column command is replaced,
+ * so the bank states (and the queue depth) stay realistic.
+ * */
+void
+bench_rank(size_t depth) {
+    std::string name = "DRAM_RANK_SELECT_QD" + std::to_string(depth);
+    if (!is_selected(name)) {
+        return;
+    }
+    DRAMRank* rank = new DRAMRank;
+    auto new_line = [] (size_t bg, size_t ba)
+    {
+        return LINEADDR(0, 0, 0, bg, ba, GL_RNG_() % 4, GL_RNG_() % NUM_COLUMNS);
+    };
+    for (size_t bg = 0; bg < NUM_BANKGROUPS; bg++) {
+        for (size_t ba = 0; ba < NUM_BANKS; ba++) {
+            for (size_t k = 0; k < depth; k++) {
+                rank->try_and_insert_command<true>(new_line(bg, ba));
+            }
+        }
+    }
+    bench(name, OPT_ops_/100,
+            [&] (uint64_t i)
+            {
+                rank->tick(++GL_dram_cycle_);
+                DRAMCommand cmd;
+                if (!rank->select_command(cmd)) {
+                    return 0;
+                }
+                rank->execute_command(cmd);
+                if (is_column_command(cmd.cmd_type_)) {
+                    rank->try_and_insert_command<true>(new_line(BANKGROUP(cmd.lineaddr_), BANK(cmd.lineaddr_)));
+                }
+                return 1;
+            });
+    delete rank;
+}
+#endif
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * Sanity checks, run before the benchmarks. Returns false on a failure.
+ *
+ * TLB reach: N distinct 4 KB pages, as many as the TLB has entries and one
+ * per set in turn, must all fit (the set index must come from the page
+ * number).
+ * */
+bool
+check_tlb_reach(std::string name, size_t entries, size_t ways) {
+    TLB tlb(entries, ways);
+    for (uint64_t vpn = 0; vpn < entries; vpn++) {
+        tlb.fill(tlb_key(vpn, 0));
+    }
+    if (tlb.valid_entries() != entries) {
+        std::cerr << "CHECK FAILED " << name << ": " << entries << " pages fill only "
+            << tlb.valid_entries() << " of " << entries << " entries\n";
+        return false;
+    }
+    return true;
+}
+
+bool
+run_checks() {
+    MMUConfig conf;
+    bool ok = true;
+    ok &= check_tlb_reach("DTLB_REACH", conf.dtlb_entries_, DTLB_ASSOC);
+    ok &= check_tlb_reach("STLB_REACH", conf.stlb_entries_, STLB_ASSOC);
+    ok &= check_tlb_reach("PWC_REACH", conf.pwc_entries_, PWC_ASSOC);
+    return ok;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * Compares `results_` against a previous run's output. Returns false if any
+ * benchmark got slower by more than `OPT_tolerance_` percent.
+ * */
+bool
+check_baseline() {
+    std::ifstream in(OPT_baseline_);
+    if (!in.is_open()) {
+        std::cerr << "sim_bench: cannot read baseline " << OPT_baseline_ << "\n";
+        exit(1);
+    }
+    std::unordered_map<std::string, double> base;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::stringstream ss(line);
+        std::string name;
+        double ns;
+        if (ss >> name >> ns) {
+            base[name] = ns;
+        }
+    }
+
+    bool ok = true;
+    for (const auto& [ name, ns ] : results_) {
+        auto it = base.find(name);
+        if (it == base.end()) {
+            continue;
+        }
+        double change = 100.0*(ns - it->second)/it->second;
+        if (change > OPT_tolerance_) {
+            std::cerr << "REGRESSION " << name << ": " << it->second << " -> " << ns
+                << " ns/op (+" << change << "%)\n";
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+init_globals() {
+    for (size_t i = 0; i < N_THREADS; i++) {
+        GL_cores_[i] = new Core(i, 4, MMUConfig{});
+    }
+    GL_os_ = new OS(DRAM_SIZE_MB, OSConfig{});
+    GL_llc_controller_ = new LLC2Controller;
+#ifdef USE_DRAMSIM3
+    GL_memory_controller_ = new DS3Interface(OPT_ds3_cfg_);
+#else
+    fill_config_for_4400_4800_5200(GL_dram_conf_);
+    fill_config_from_ini(GL_dram_conf_, OPT_ds3_cfg_);
+    GL_memory_controller_ = new DRAMController;
+#endif
+}
+
+int main(int argc, char* argv[]) {
+    std::ios_base::sync_with_stdio(false);
+
+    ArgParseResult ARGS = parse(argc, argv,
+            { // REQUIRED
+            },
+            { // OPTIONAL
+                { "filter", "Only run benchmarks whose name contains this", "all" },
+                { "ops", "Operations per timed run", "1000000" },
+                { "baseline", "Output of a previous run: exit with 1 if a benchmark regressed", "none" },
+                { "tolerance", "Allowed slowdown against -baseline (percent)", "10" },
+                { "ds3cfg", "DRAMSim3 config file (*.ini)", "../../ds3conf/base.ini" }
+            });
+    ARGS("filter", OPT_filter_);
+    ARGS("ops", OPT_ops_);
+    ARGS("baseline", OPT_baseline_);
+    ARGS("tolerance", OPT_tolerance_);
+    ARGS("ds3cfg", OPT_ds3_cfg_);
+
+    init_globals();
+
+    bool ok = run_checks();
+
+    bench_cache<CacheReplPolicy::LRU>("LRU");
+    bench_cache<CacheReplPolicy::RAND>("RAND");
+    bench_cache<CacheReplPolicy::SRRIP>("SRRIP");
+    bench_cache<CacheReplPolicy::BRRIP>("BRRIP");
+    bench_cache_controller();
+    bench_os();
+    bench_trace();
+    bench_memory();
+#ifndef USE_DRAMSIM3
+    // Last: these advance `GL_dram_cycle_` without the controller.
+    for (size_t depth : { 1, 8, 32 }) {
+        bench_rank(depth);
+    }
+#endif
+
+    ok &= OPT_baseline_ == "none" || check_baseline();
+
+    for (size_t i = 0; i < N_THREADS; i++) {
+        delete GL_cores_[i];
+    }
+    delete GL_os_;
+    delete GL_llc_controller_;
+    delete GL_memory_controller_;
+
+    return ok ? 0 : 1;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
@@ -17,9 +17,12 @@
 #endif
 
 #include <utils/argparse.h>
+#include <utils/fastdiv.h>
 #include <utils/timer.h>
 
 #include <iostream>
+#include <sstream>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
@@ -66,6 +69,24 @@ void print_announcement(std::string);
 std::string OPT_trace_file_;
 std::string OPT_ds3_cfg_;
 uint64_t OPT_num_inst_;
+std::string OPT_frame_alloc_;
+std::string OPT_thp_;
+std::string OPT_thp_size_;
+uint64_t OPT_thp_promote_;
+uint64_t OPT_dtlb_;
+uint64_t OPT_stlb_;
+uint64_t OPT_pwc_;
+bool OPT_tlb_;
+uint64_t OPT_near_mb_;
+uint64_t OPT_far_latency_;
+double OPT_far_gbps_;
+uint64_t OPT_migrate_epoch_;
+uint64_t OPT_migrate_pages_;
+uint64_t OPT_hot_threshold_;
+uint64_t OPT_procs_per_core_;
+uint64_t OPT_quantum_;
+uint64_t OPT_ctx_switch_cycles_;
+bool OPT_ctx_flush_tlb_;
 
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
@@ -81,11 +102,47 @@ int main(int argc, char* argv[]) {
             },
             { // OPTIONAL
                 { "ds3cfg", "DRAMSim3 config file (*.ini)", "../../ds3conf/base.ini" },
-                { "inst", "Number of instructions to simulate", "10000000" }
+                { "inst", "Number of instructions to simulate", "10000000" },
+                { "frame_alloc", "Physical frame allocation policy (random, buddy, sequential, color, bank_spread, bank_pack)", "random" },
+                { "thp", "Transparent huge pages (never, always, promote); needs -frame_alloc buddy", "never" },
+                { "thp_size", "Huge page size (2M, 1G)", "2M" },
+                { "thp_promote", "THP promote: base pages mapped in a huge region before it is promoted", "256" },
+                { "dtlb", "L1 dTLB entries (4-way)", "64" },
+                { "stlb", "L2 STLB entries (12-way)", "1536" },
+                { "pwc", "Page walk cache entries per page table level (4-way)", "32" },
+                { "tlb", "Model TLBs and page walks (otherwise translation is free)", "" },
+                { "near_mb", "Tiered memory: size of the near tier in MB, the rest is far (0 disables tiering)", "0" },
+                { "far_latency", "Tiered memory: extra cycles for each far tier access", "280" },
+                { "far_gbps", "Tiered memory: far tier bandwidth (GB/s)", "32" },
+                { "migrate_epoch", "Tiered memory: cycles between migration daemon runs", "1000000" },
+                { "migrate_pages", "Tiered memory: maximum pages promoted per migration epoch", "64" },
+                { "hot_threshold", "Tiered memory: memory accesses per epoch (aged) for a far page to be promoted", "8" },
+                { "procs_per_core", "Processes time-sliced on each core; process p runs trace p (mod the number of traces) on core p (mod N_THREADS)", "1" },
+                { "quantum", "Cycles in a scheduler time slice", "4000000" },
+                { "ctx_switch_cycles", "Cycles a core stalls for on a context switch", "8000" },
+                { "ctx_flush_tlb", "Flush the TLBs on a context switch (instead of relying on ASIDs)", "" }
             });
     ARGS("trace", OPT_trace_file_);
     ARGS("ds3cfg", OPT_ds3_cfg_);
     ARGS("inst", OPT_num_inst_);
+    ARGS("frame_alloc", OPT_frame_alloc_);
+    ARGS("thp", OPT_thp_);
+    ARGS("thp_size", OPT_thp_size_);
+    ARGS("thp_promote", OPT_thp_promote_);
+    ARGS("dtlb", OPT_dtlb_);
+    ARGS("stlb", OPT_stlb_);
+    ARGS("pwc", OPT_pwc_);
+    ARGS("tlb", OPT_tlb_);
+    ARGS("near_mb", OPT_near_mb_);
+    ARGS("far_latency", OPT_far_latency_);
+    ARGS("far_gbps", OPT_far_gbps_);
+    ARGS("migrate_epoch", OPT_migrate_epoch_);
+    ARGS("migrate_pages", OPT_migrate_pages_);
+    ARGS("hot_threshold", OPT_hot_threshold_);
+    ARGS("procs_per_core", OPT_procs_per_core_);
+    ARGS("quantum", OPT_quantum_);
+    ARGS("ctx_switch_cycles", OPT_ctx_switch_cycles_);
+    ARGS("ctx_flush_tlb", OPT_ctx_flush_tlb_);
 
     init_globals();
     /*
@@ -126,15 +183,16 @@ int main(int argc, char* argv[]) {
 
         tt.start();
         
+        GL_os_->tick();
         GL_llc_controller_->tick();
         size_t ii = first;
         for (size_t i = 0; i < N_THREADS; i++) {
             Core* c = GL_cores_[ii];
             c->tick();
             all_done &= (c->finished_inst_num_ >= OPT_num_inst_);
-            ii = INCREMENT_AND_MOD_BY_POW2(ii, N_THREADS);
+            ii = FastDiv<N_THREADS>::mod(ii+1);
         }
-        first = INCREMENT_AND_MOD_BY_POW2(first, N_THREADS);
+        first = FastDiv<N_THREADS>::mod(first+1);
 
         t_ns_spent_in_core += tt.end();
 
@@ -159,17 +217,49 @@ int main(int argc, char* argv[]) {
 
 void
 init_globals() {
+    MMUConfig mmu_conf;
+    mmu_conf.dtlb_entries_ = OPT_dtlb_;
+    mmu_conf.stlb_entries_ = OPT_stlb_;
+    mmu_conf.pwc_entries_ = OPT_pwc_;
+    mmu_conf.perfect_ = !OPT_tlb_;
     for (size_t i = 0; i < N_THREADS; i++) {
-        GL_cores_[i] = new Core(i, 4);
-        GL_cores_[i]->set_trace_file(OPT_trace_file_);
+        GL_cores_[i] = new Core(i, 4, mmu_conf);
+    }
+    OSConfig os_conf;
+    os_conf.frame_alloc_policy = frame_alloc_policy_from_name(OPT_frame_alloc_);
+    os_conf.thp_policy = thp_policy_from_name(OPT_thp_);
+    os_conf.thp_level = thp_level_from_size(OPT_thp_size_);
+    os_conf.thp_promote_pages = OPT_thp_promote_;
+    os_conf.tiers.near_mb = OPT_near_mb_;
+    os_conf.tiers.far_latency = OPT_far_latency_;
+    os_conf.tiers.far_gbps = OPT_far_gbps_;
+    os_conf.tiers.migrate_epoch = OPT_migrate_epoch_;
+    os_conf.tiers.migrate_pages = OPT_migrate_pages_;
+    os_conf.tiers.hot_threshold = OPT_hot_threshold_;
+    os_conf.procs_per_core = OPT_procs_per_core_;
+    os_conf.quantum = OPT_quantum_;
+    os_conf.ctx_switch_cycles = OPT_ctx_switch_cycles_;
+    os_conf.ctx_flush_tlb = OPT_ctx_flush_tlb_;
+    GL_os_ = new OS(DRAM_SIZE_MB, os_conf);
+    // `-trace` is a comma-separated list. With one process per core, the ASID
+    // is the core id.
+    std::vector<std::string> traces;
+    std::stringstream trace_list(OPT_trace_file_);
+    for (std::string t; std::getline(trace_list, t, ',');) {
+        traces.push_back(t);
+    }
+    for (size_t p = 0; p < N_THREADS*OPT_procs_per_core_; p++) {
+        GL_os_->add_process(traces[p % traces.size()], p % N_THREADS);
     }
-    GL_os_ = new OS(DRAM_SIZE_MB);
     GL_llc_controller_ = new LLC2Controller;
 #ifdef USE_DRAMSIM3
     GL_memory_controller_ = new DS3Interface(OPT_ds3_cfg_);
 #else
-    GL_memory_controller_ = new DRAMController;
+    // The config must be filled before the controller is built (ranks read it
+    // to build their row-hammer mitigations).
     fill_config_for_4400_4800_5200(GL_dram_conf_);
+    fill_config_from_ini(GL_dram_conf_, OPT_ds3_cfg_);
+    GL_memory_controller_ = new DRAMController;
 #endif
 }
 
@@ -209,6 +299,36 @@ print_sim_config() {
     list("TRACE", OPT_trace_file_);
     list("DS3CFG", OPT_ds3_cfg_);
     list("INST", FMT_BIGNUM(OPT_num_inst_));
+    list("FRAME_ALLOC", frame_alloc_policy_name(GL_os_->conf_.frame_alloc_policy));
+    list("THP", thp_policy_name(GL_os_->conf_.thp_policy));
+    if (GL_os_->conf_.thp_policy != THPPolicy::NEVER) {
+        list("THP_SIZE", OPT_thp_size_);
+    }
+    if (GL_os_->conf_.thp_policy == THPPolicy::PROMOTE) {
+        list("THP_PROMOTE_PAGES", GL_os_->conf_.thp_promote_pages);
+    }
+    if (GL_os_->tiers_ != nullptr) {
+        const TierConfig& t = GL_os_->conf_.tiers;
+        list("NEAR_TIER_MB", t.near_mb);
+        list("FAR_TIER_LATENCY", t.far_latency);
+        list("FAR_TIER_GBPS", t.far_gbps);
+        list("MIGRATE_EPOCH", t.migrate_epoch);
+        list("MIGRATE_PAGES", t.migrate_pages);
+        list("HOT_THRESHOLD", t.hot_threshold);
+    }
+    if (!OPT_tlb_) {
+        list("TLB", "perfect");
+    } else {
+        list("DTLB_ENTRIES", OPT_dtlb_);
+        list("STLB_ENTRIES", OPT_stlb_);
+        list("PWC_ENTRIES", OPT_pwc_);
+    }
+    if (OPT_procs_per_core_ > 1) {
+        list("PROCS_PER_CORE", OPT_procs_per_core_);
+        list("QUANTUM", OPT_quantum_);
+        list("CTX_SWITCH_CYCLES", OPT_ctx_switch_cycles_);
+        list("CTX_FLUSH_TLB", OPT_ctx_flush_tlb_);
+    }
 
     std::cout << "\n---------------------------------------------\n\n";
 
@@ -234,6 +354,7 @@ print_sim_config() {
     list("DRAM_BANK_SIZE_MB", BANK_SIZE_MB);
     list("DRAM_ROW_SIZE", NUM_COLUMNS*COLUMN_WIDTH/8);
 
+#ifndef USE_DRAMSIM3
     std::cout << "\n---------------------------------------------\n\n";
 
     list("tCAS (ns)", GL_dram_conf_.CL * GL_dram_conf_.tCK);
@@ -243,6 +364,40 @@ print_sim_config() {
     list("tRFC (ns)", GL_dram_conf_.tRFC * GL_dram_conf_.tCK);
     list("tREFI (us)", GL_dram_conf_.tREFI * GL_dram_conf_.tCK * 1e-3);
 
+    list("DRAM_PAGE_POLICY", page_policy_name(GL_dram_conf_.page_policy));
+    if (GL_dram_conf_.page_policy == DRAMPagePolicy::TIMEOUT) {
+        list("DRAM_PAGE_TIMEOUT (ns)", GL_dram_conf_.page_timeout * GL_dram_conf_.tCK);
+    }
+    list("DRAM_MAX_ROW_HITS", GL_dram_conf_.max_consecutive_column_accesses);
+
+    if (mitigation_is_enabled(GL_dram_conf_)) {
+        std::cout << "\n---------------------------------------------\n\n";
+
+        list("RFM_MODE", GL_dram_conf_.rfm_mode);
+        if (GL_dram_conf_.rfm_mode != 0) {
+            list("RAAIMT", GL_dram_conf_.raaimt);
+            list("RAAMMT", GL_dram_conf_.raammt);
+            list("tRFM (ns)", GL_dram_conf_.tRFM * GL_dram_conf_.tCK);
+            list("tRFMsb (ns)", GL_dram_conf_.tRFMsb * GL_dram_conf_.tCK);
+        }
+        list("ALERT_MODE", GL_dram_conf_.alert_mode);
+        if (GL_dram_conf_.alert_mode != 0) {
+            list("tABO_act (ns)", GL_dram_conf_.tABO_act * GL_dram_conf_.tCK);
+            list("ABO_DELAY_ACTS", GL_dram_conf_.ABO_delay_acts);
+        }
+        list("ROWS_PER_REF", GL_dram_conf_.rows_refreshed);
+        if (GL_dram_conf_.moat_mode != 0) {
+            list("MOAT_THRESHOLD", GL_dram_conf_.moatth);
+        }
+        if (GL_dram_conf_.mirza_mode != 0) {
+            list("MIRZA_GROUPS", GL_dram_conf_.mirza_groups);
+            list("MIRZA_GROUP_THRESHOLD", GL_dram_conf_.mirza_groupth);
+            list("MIRZA_QUEUE_SIZE", GL_dram_conf_.mirza_qsize);
+            list("MIRZA_QUEUE_THRESHOLD", GL_dram_conf_.mirza_qth);
+            list("MIRZA_MINTW", GL_dram_conf_.mirza_mintw);
+        }
+    }
+#endif
 
     std::cout << "\n---------------------------------------------\n\n";
 
@@ -7,6 +7,7 @@
 #define CACHE_h
 
 #include "defs.h"
+#include "utils/fastdiv.h"
 
 #include <array>
 #include <deque>
@@ -50,11 +51,15 @@ struct CacheSet : public std::unordered_map<uint64_t, CacheEntry> {
 /*
  * General class for caches. Replacement policy
  * is LRU.
+ *
+ * The number of sets need not be a power of two (e.g. 12 ways, or 3 MB per
+ * core): the set is the line address modulo `SETS` (see `FastDiv`).
  * */
 template <size_t SIZE_KB, size_t WAYS, CacheReplPolicy REPL_POLICY=CacheReplPolicy::LRU>
 class Cache {
 public:
     constexpr static size_t SETS = (SIZE_KB*1024)/(WAYS*LINESIZE);
+    static_assert(SETS*WAYS*LINESIZE == SIZE_KB*1024, "Cache: size is not a whole number of sets");
 
     uint64_t s_misses_ =0;
     uint64_t s_accesses_ =0;
@@ -3,7 +3,7 @@
  *  date:   10 October 2024
  * */
 
-#include "utils/bitcount.h"
+#include "utils/fastdiv.h"
 #include "os.h"
 
 #include <iomanip>
@@ -145,13 +145,12 @@ __TEMPLATE_CLASS__::print_stats(std::ostream& out, std::string_view cache_name)
 
 __TEMPLATE_HEADER__ inline void
 __TEMPLATE_CLASS__::split_lineaddr(uint64_t lineaddr, uint64_t& t, uint64_t& s) {
-    s = lineaddr & (SETS-1);
-    t = lineaddr >> Log2<SETS>::value;
+    FastDiv<SETS>::divmod(lineaddr, t, s);
 }
 
 __TEMPLATE_HEADER__ inline uint64_t
 __TEMPLATE_CLASS__::join_lineaddr(uint64_t t, uint64_t s) {
-    return (t << Log2<SETS>::value) | s;
+    return t*SETS + s;
 }
 
 ////////////////////////////////////////////////////////////////
@@ -5,6 +5,7 @@
 
 #include "cache/controller/llc2.h"
 #include "core.h"
+#include "os.h"
 
 #ifdef USE_DRAMSIM3
 #include "ds3/interface.h"
@@ -17,6 +18,10 @@
 
 void
 LLC2Controller::update_prev_level(uint64_t lineaddr, size_t coreid, size_t robid, uint64_t when) {
+    if (robid == MMU_ROBID) {
+        GL_cores_[coreid]->mmu_.walk_step_done(when);
+        return;
+    }
     GL_cores_[coreid]->rob_[robid].end_cycle_ = when;
 }
 
@@ -25,6 +30,9 @@ LLC2Controller::update_prev_level(uint64_t lineaddr, size_t coreid, size_t robid
 
 int
 LLC2Controller::access_next_level(uint64_t lineaddr, size_t coreid, size_t robid, uint64_t inst_num, bool is_load) {
+    if (GL_os_->tiers_ != nullptr) {
+        return GL_os_->tiers_->access(lineaddr, is_load) ? 1 : -1;
+    }
     return GL_memory_controller_->make_request(lineaddr, is_load) ? 1 : -1;
 }
 
@@ -6,6 +6,8 @@
 #include "core.h"
 #include "cache/controller/llc2.h"
 #include "os.h"
+
+#include <algorithm>
 #include <iostream>
 
 #include <stdlib.h>
@@ -14,15 +16,12 @@
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 
-Core::Core(size_t coreid, size_t fw)
-    :coreid_(coreid),
+Core::Core(size_t coreid, size_t fw, const MMUConfig& mmu_conf)
+    :mmu_(coreid, mmu_conf),
+    coreid_(coreid),
     fetch_width_(fw)
 {}
 
-Core::~Core() {
-    gzclose(trace_in_);
-}
-
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 
@@ -30,14 +29,39 @@ void
 Core::tick() {
     // Try and retire ROB entries.
     rob_retire();
+    // Advance the page walk, if there is one.
+    mmu_.tick();
+
+    if (GL_cycle_ >= slice_end_) {
+        context_switch();
+    }
+    if (GL_cycle_ < ctx_switch_end_ || GL_cycle_ < shootdown_end_) {
+        return;
+    }
+    auto& inst = proc_->next_inst_;
 
     size_t robid = (rob_ptr_+rob_size_) & (ROB_WIDTH-1);
     for (size_t i = 0; i < fetch_width_ && rob_size_ < ROB_WIDTH; i++) {
         // Setup ROB entry early. If we end up not using it, no harm, no foul.
         rob_[robid] = { curr_inst_num_, GL_cycle_, GL_cycle_ };
-        if (curr_inst_num_ >= next_inst_.num) {
-            bool is_load = !next_inst_.is_wb;
-            uint64_t lineaddr = GL_os_->v2p( next_inst_.vla );
+        if (proc_->trace_inst_num_ >= inst.num) {
+            // Stall while the page walk for this instruction is in flight, and
+            // then for the TLB latency.
+            if (!xlat_valid_) {
+                uint64_t vpn = inst.vla >> Log2<LINES_PER_PAGE>::value,
+                         tlb_latency;
+                if (!mmu_.translate(vpn, xlat_begin_cycle_, tlb_latency)) {
+                    return;
+                }
+                xlat_valid_ = true;
+                xlat_ready_cycle_ = GL_cycle_ + tlb_latency;
+            }
+            if (GL_cycle_ < xlat_ready_cycle_) {
+                return;
+            }
+            rob_[robid].begin_cycle_ = xlat_begin_cycle_;
+            bool is_load = !inst.is_wb;
+            uint64_t lineaddr = GL_os_->v2p( inst.vla, coreid_ );
             if (is_load) { // Need to wait for access to finish.
                 rob_[robid].end_cycle_ = GL_cycle_ + BAD_LATENCY;
             }
@@ -46,23 +70,39 @@ Core::tick() {
                 ++s_mshr_full_;
                 return;
             } else {
+                xlat_valid_ = false;
                 ++s_llc_accesses_;
                 if (retval == 0) {
                     ++s_llc_misses_;
                 }
             }
-            read_next_inst();
+#ifdef COMPRESSION_TRACES
+            if (!is_load) {
+                GL_os_->write_line( inst.vla, inst.linedata );
+            }
+#endif
+            proc_->read_next_inst();
         }
         ++rob_size_;
         robid = INCREMENT_AND_MOD_BY_POW2(robid, ROB_WIDTH);
         
         ++curr_inst_num_;
+        ++proc_->trace_inst_num_;
+        ++proc_->s_inst_;
     }
 }
 
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 
+void
+Core::tlb_shootdown(uint64_t cycles) {
+    shootdown_end_ = std::max(shootdown_end_, GL_cycle_) + cycles;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
 void
 Core::print_stats(std::ostream& out) {
     std::string header = "CORE_" + std::to_string(coreid_);
@@ -78,6 +118,10 @@ Core::print_stats(std::ostream& out) {
     PRINT_STAT(out, header + "_ACCESSES", s_llc_accesses_);
     PRINT_STAT(out, header + "_MPKI", mpki);
     PRINT_STAT(out, header + "_APKI", apki);
+    if (GL_os_->conf_.procs_per_core > 1) {
+        PRINT_STAT(out, header + "_CTX_SWITCHES", s_ctx_switches_);
+    }
+    mmu_.print_stats(out, header);
 //  PRINT_STAT(out, header + "_SLEEP", s_mshr_full_);
 //  PRINT_STAT(out, header + "_DELAY", delay);
     out << "\n";
@@ -104,16 +148,6 @@ Core::dump_debug_info(std::ostream& out) {
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 
-void
-Core::set_trace_file(std::string f) {
-    trace_file_ = f;
-    trace_in_ = gzopen(f.c_str(), "r");
-    read_next_inst();
-}
-
-////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////
-
 void
 Core::rob_retire() {
     for (size_t i = 0; i < fetch_width_ && rob_size_ > 0; i++) {
@@ -135,46 +169,27 @@ Core::rob_retire() {
 ////////////////////////////////////////////////////////////////
 
 void
-Core::read_next_inst() {
-    if (gzeof(trace_in_)) {
-        gzclose(trace_in_);
-        // Reread trace file.
-        trace_in_ = gzopen(trace_file_.c_str(), "r");
-        // Reset `curr_inst_num_`, and update `inst_num_offset_`.
-        inst_num_offset_ = curr_inst_num_;
-        curr_inst_num_ = 0;
+Core::context_switch() {
+    Process* next = GL_os_->schedule(coreid_);
+    slice_end_ = GL_cycle_ + GL_os_->conf_.quantum;
+    ++next->s_slices_;
+    if (next == proc_) {
+        return;
     }
-#ifdef COMPRESSION_TRACES
-    // If we already have WB data, just use that.
-    if (trace_wb_data_.valid) {
-        trace_wb_data_.valid = false;
-        next_inst_.vla = trace_wb_data_.vla;
-        next_inst_.is_wb = true;
-        memmove( next_inst_.linedata, trace_wb_data_.linedata, 64 );
-    } else {
-        gzread( trace_in_, &next_inst_.num, 8 );
-        gzseek( trace_in_, 1, SEEK_CUR);
-        gzread( trace_in_, &next_inst_.vla, 8 );
-
-        next_inst_.is_wb = false;
-
-        gzread( trace_in_, &trace_wb_data_.valid, 1 );
-        if (trace_wb_data_.valid) {
-            gzread( trace_in_, &trace_wb_data_.vla, 8 );
-            gzread( trace_in_, trace_wb_data_.linedata, 64 );
+    // The pending translation was for the old process.
+    xlat_valid_ = false;
+    if (proc_ != nullptr) {
+        // The new process starts fetching once the switch is over. TLB entries
+        // are ASID-tagged, so they only go if asked to.
+        ctx_switch_end_ = GL_cycle_ + GL_os_->conf_.ctx_switch_cycles;
+        slice_end_ += GL_os_->conf_.ctx_switch_cycles;
+        if (GL_os_->conf_.ctx_flush_tlb) {
+            mmu_.flush();
         }
-
+        ++s_ctx_switches_;
     }
-    next_inst_.vla >>= Log2<LINESIZE>::value; // Note that the given addresses are virtual byte addresses,
-                                                  // not LINE addresses.
-#else
-    gzread( trace_in_, &next_inst_.num, 5 );
-    gzread( trace_in_, &next_inst_.is_wb, 1 );
-    gzread( trace_in_, &next_inst_.vla, 4);
-#endif
-    TAG_VA_WITH_COREID(next_inst_.vla, coreid_);
+    proc_ = next;
 }
 
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
-
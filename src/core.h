@@ -5,6 +5,8 @@
 #define CORE_h
 
 #include "defs.h"
+#include "mmu.h"
+#include "os/process.h"
 
 #include <array>
 #include <deque>
@@ -12,7 +14,6 @@
 #include <string>
 
 #include <stdint.h>
-#include <zlib.h>
 
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
@@ -40,6 +41,7 @@ public:
      * Microarchitectural structures.
      * */
     ROBEntry rob_[ROB_WIDTH];
+    MMU      mmu_;
 
     size_t rob_ptr_ =0;
     size_t rob_size_ =0;
@@ -51,47 +53,39 @@ public:
     uint64_t s_mshr_full_ =0;
     uint64_t s_llc_misses_ =0;
     uint64_t s_llc_accesses_ =0;
-private:
-    uint64_t inst_num_offset_ =0;
-    /*
-     * Simulation files.
-     * */
-    std::string trace_file_;
-    gzFile trace_in_;
+    uint64_t s_ctx_switches_ =0;
     /*
-     * Instructions are ready from `trace_in_` and placed in this structure. Once the
-     * core catches up to this instruction (see `curr_inst_num_`, the instruction is
-     * handled.
+     * The running process (see `OS::schedule`). Its time slice ends at
+     * `slice_end_`, and after a context switch the core does not fetch until
+     * `ctx_switch_end_` (after a TLB shootdown, until `shootdown_end_`).
      * */
-    struct {
-        uint64_t num;
-        uint64_t vla;  // virtual line address
-        bool is_wb;
-        char linedata[64];
-    } next_inst_;
+    Process* proc_ =nullptr;
+private:
+    uint64_t slice_end_ =0;
+    uint64_t ctx_switch_end_ =0;
+    uint64_t shootdown_end_ =0;
     /*
-     * Traces package reads and writes together. However, we want to split them up
-     * in case either fails (need to spin on cache controller).
+     * The translation of the next memory instruction, kept until its access
+     * is accepted (so a retry after a full MSHR neither translates again nor
+     * loses the TLB latency). The access is issued at `xlat_ready_cycle_`.
      * */
-    struct {
-        bool valid=false;
-        uint64_t vla;
-        char linedata[64];
-    } trace_wb_data_;
+    bool     xlat_valid_ =false;
+    uint64_t xlat_begin_cycle_ =0;
+    uint64_t xlat_ready_cycle_ =0;
 public:
-    Core(size_t coreid, size_t fetch_width);
-    ~Core(void);
+    Core(size_t coreid, size_t fetch_width, const MMUConfig&);
 
     void tick(void);
-    void print_stats(std::ostream&);
-    void dump_debug_info(std::ostream&);
     /*
-     * Sets `trace_in_` and `trace_file_`, and also calls `read_next_inst`.
+     * Interrupts the core for a TLB shootdown (see `OS::move_page`): it does
+     * not fetch for `cycles`.
      * */
-    void set_trace_file(std::string);
+    void tlb_shootdown(uint64_t cycles);
+    void print_stats(std::ostream&);
+    void dump_debug_info(std::ostream&);
 private:
     void rob_retire(void);
-    void read_next_inst(void);
+    void context_switch(void);
 };
 
 ////////////////////////////////////////////////////////////////
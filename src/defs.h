@@ -34,8 +34,20 @@ repl_policy_name(CacheReplPolicy p) {
     return "Unknown Cache Policy";
 }
 
-enum class DRAMPagePolicy { OPEN, CLOSED };
+enum class DRAMPagePolicy { OPEN, CLOSED, SOFT_CLOSE, TIMEOUT, PREDICTIVE };
 enum class DRAMRefreshMethod { REFAB, REFSB };
+
+inline std::string_view
+page_policy_name(DRAMPagePolicy p) {
+    if (p == DRAMPagePolicy::OPEN)          return "Open";
+    if (p == DRAMPagePolicy::CLOSED)        return "Closed";
+    if (p == DRAMPagePolicy::SOFT_CLOSE)    return "Soft Close";
+    if (p == DRAMPagePolicy::TIMEOUT)       return "Timeout";
+    if (p == DRAMPagePolicy::PREDICTIVE)    return "Predictive";
+    return "Unknown Page Policy";
+}
+
+enum class DRAMWriteDrainMode { WATERMARK, READ_PRIORITY };
 enum class DRAMCommandType {
     READ, 
     WRITE,
@@ -77,7 +89,6 @@ constexpr size_t SRRIP_WIDTH = 3;
  * DRAM definitions.
  * */
 
-constexpr DRAMPagePolicy    DRAM_PAGE_POLICY = DRAMPagePolicy::OPEN;
 constexpr DRAMRefreshMethod DRAM_REFRESH = DRAMRefreshMethod::REFAB;
 /*
  * Note on below constants: -- they are for an x4 32GB single channel system.
@@ -155,8 +166,13 @@ extern std::mt19937_64  GL_RNG_;
 ////////////////////////////////////////////////////////////////
 
 inline void 
-TAG_VA_WITH_COREID(uint64_t& va, size_t coreid) {
-    va |= static_cast<uint64_t>(coreid) << 48;
+TAG_VA_WITH_ASID(uint64_t& va, size_t asid) {
+    va |= static_cast<uint64_t>(asid) << 48;
+}
+
+inline size_t
+ASID_OF_VA(uint64_t va) {
+    return static_cast<size_t>(va >> 48);
 }
 
 ////////////////////////////////////////////////////////////////
@@ -191,6 +207,11 @@ std::string FMT_BIGNUM(uint64_t num) {
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 
+/*
+ * Only for sizes that are always powers of two (ROB, queues). For sizes that
+ * come from the configuration (sets, channels, cores), use `FastDiv`
+ * (`utils/fastdiv.h`).
+ * */
 #define MOD_BY_POW2(x,mod)  ((x) & ((mod)-1))
 
 #define INCREMENT_AND_MOD(x,mod)            ((++(x))==(mod)) ? 0 : (x)
@@ -7,7 +7,7 @@
 #define DRAM_ADDRESS_h
 
 #include "defs.h"
-#include "utils/bitcount.h"
+#include "utils/fastdiv.h"
 
 #include <stdint.h>
 
@@ -26,20 +26,22 @@ uint64_t BANKGROUP(uint64_t);
 uint64_t BANK(uint64_t);
 uint64_t ROW(uint64_t);
 uint64_t COLUMN(uint64_t);
+/*
+ * Inverse of the above: the line address at the given coordinates.
+ * */
+uint64_t LINEADDR(uint64_t ch, uint64_t sc, uint64_t ra, uint64_t bg, uint64_t ba, uint64_t row, uint64_t col);
 
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
-
-constexpr size_t B_CH = Log2<NUM_CHANNELS>::value;
-constexpr size_t B_SC = Log2<NUM_SUBCHANNELS>::value;
-constexpr size_t B_RA = Log2<NUM_RANKS>::value;
-constexpr size_t B_BG = Log2<NUM_BANKGROUPS>::value;
-constexpr size_t B_BA = Log2<NUM_BANKS>::value;
-constexpr size_t B_RO = Log2<NUM_ROWS>::value;
-constexpr size_t B_CO = Log2<NUM_COLUMNS>::value;
-
-inline constexpr uint64_t MASK(size_t B) {
-    return (1L << B) - 1;
+/*
+ * A mapping is a mixed-radix number: each field has a stride (the product of
+ * the sizes of the fields below it) and a size, neither of which needs to be a
+ * power of two (e.g. 6 or 12 channels). With powers of two, this is a shift
+ * and a mask.
+ * */
+template <uint64_t STRIDE, uint64_t SIZE>
+inline uint64_t ADDRESS_FIELD(uint64_t x) {
+    return FastDiv<SIZE>::mod( FastDiv<STRIDE>::div(x) );
 }
 
 ////////////////////////////////////////////////////////////////
@@ -6,34 +6,54 @@
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 
-constexpr size_t B_LOW = 2;
+/*
+ * From the lowest field: 4 columns, subchannel, channel, bankgroup, bank,
+ * rank, the rest of the column, row.
+ * */
+constexpr uint64_t N_LOW = 4;
+constexpr uint64_t N_HI = NUM_COLUMNS / N_LOW;
 
-constexpr size_t SC_OFF = B_LOW;
-constexpr size_t CH_OFF = SC_OFF + B_SC;
-constexpr size_t BG_OFF = CH_OFF + B_CH;
-constexpr size_t BA_OFF = BG_OFF + B_BG;
-constexpr size_t RA_OFF = BA_OFF + B_BA;
-constexpr size_t HI_OFF = RA_OFF + B_RA;
-constexpr size_t RO_OFF = HI_OFF + (B_CO-B_LOW);
+constexpr uint64_t SC_STRIDE = N_LOW;
+constexpr uint64_t CH_STRIDE = SC_STRIDE * NUM_SUBCHANNELS;
+constexpr uint64_t BG_STRIDE = CH_STRIDE * NUM_CHANNELS;
+constexpr uint64_t BA_STRIDE = BG_STRIDE * NUM_BANKGROUPS;
+constexpr uint64_t RA_STRIDE = BA_STRIDE * NUM_BANKS;
+constexpr uint64_t HI_STRIDE = RA_STRIDE * NUM_RANKS;
+constexpr uint64_t RO_STRIDE = HI_STRIDE * N_HI;
 
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 
-inline uint64_t CHANNEL(uint64_t x)     { return (x >> CH_OFF) & MASK(B_CH); }
-inline uint64_t SUBCHANNEL(uint64_t x)  { return (x >> SC_OFF) & MASK(B_SC); }
-inline uint64_t RANK(uint64_t x)        { return (x >> RA_OFF) & MASK(B_RA); }
-inline uint64_t BANKGROUP(uint64_t x)   { return (x >> BG_OFF) & MASK(B_BG); }
-inline uint64_t BANK(uint64_t x)        { return (x >> BA_OFF) & MASK(B_BA); }
-inline uint64_t ROW(uint64_t x)         { return (x >> RO_OFF) & MASK(B_RO); }
+inline uint64_t CHANNEL(uint64_t x)     { return ADDRESS_FIELD<CH_STRIDE, NUM_CHANNELS>(x); }
+inline uint64_t SUBCHANNEL(uint64_t x)  { return ADDRESS_FIELD<SC_STRIDE, NUM_SUBCHANNELS>(x); }
+inline uint64_t RANK(uint64_t x)        { return ADDRESS_FIELD<RA_STRIDE, NUM_RANKS>(x); }
+inline uint64_t BANKGROUP(uint64_t x)   { return ADDRESS_FIELD<BG_STRIDE, NUM_BANKGROUPS>(x); }
+inline uint64_t BANK(uint64_t x)        { return ADDRESS_FIELD<BA_STRIDE, NUM_BANKS>(x); }
+inline uint64_t ROW(uint64_t x)         { return ADDRESS_FIELD<RO_STRIDE, NUM_ROWS>(x); }
 
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 
 inline uint64_t 
 COLUMN(uint64_t x) { 
-    uint64_t lwr = x & MASK(B_LOW),
-             upp = (x >> HI_OFF) & MASK(B_CO-B_LOW);
-    return lwr | (upp << B_LOW);
+    uint64_t lwr = FastDiv<N_LOW>::mod(x),
+             upp = ADDRESS_FIELD<HI_STRIDE, N_HI>(x);
+    return lwr + upp*N_LOW;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+inline uint64_t
+LINEADDR(uint64_t ch, uint64_t sc, uint64_t ra, uint64_t bg, uint64_t ba, uint64_t row, uint64_t col) {
+    return FastDiv<N_LOW>::mod(col)
+            + sc*SC_STRIDE
+            + ch*CH_STRIDE
+            + bg*BG_STRIDE
+            + ba*BA_STRIDE
+            + ra*RA_STRIDE
+            + FastDiv<N_LOW>::div(col)*HI_STRIDE
+            + row*RO_STRIDE;
 }
 
 ////////////////////////////////////////////////////////////////
@@ -13,18 +13,34 @@
 ////////////////////////////////////////////////////////////////
 
 struct DRAMBank {
-    constexpr static size_t MAX_CONSECUTIVE_COLUMN_ACCESSES = 4;
+    /*
+     * 2-bit saturating counter for `DRAMPagePolicy::PREDICTIVE`: rows are
+     * kept open if `row_hit_predictor_ >= ROW_HIT_PREDICTOR_THRESHOLD`.
+     * */
+    constexpr static uint8_t ROW_HIT_PREDICTOR_MAX = 3;
+    constexpr static uint8_t ROW_HIT_PREDICTOR_THRESHOLD = 2;
     /*
      * `open_row_ == -1` means no row is in the global row buffer.
+     * `last_open_row_` is the most recently opened row (even if closed), and
+     * `open_lineaddr_` is the address of the ACT that opened it.
      * */
     int64_t open_row_ =-1;
+    int64_t last_open_row_ =-1;
+    uint64_t open_lineaddr_ =0;
 
     uint64_t busy_with_ref_until_dram_cycle_ =0;
     /*
-     * Row should be precharged after `MAX_CONSECTIVE_COLUMN_ACCESSES` is hit,
-     * provided that the bank has no other outstanding accesses to the open row.
+     * Row should be precharged after `max_consecutive_column_accesses` (see
+     * `DRAMConfig`) is hit, provided that the bank has no other outstanding
+     * accesses to the open row.
      * */
     size_t consecutive_column_accesses_ =0;
+    /*
+     * Page policy state: `last_access_dram_cycle_` is used for
+     * `DRAMPagePolicy::TIMEOUT`.
+     * */
+    uint64_t last_access_dram_cycle_ =0;
+    uint8_t row_hit_predictor_ =ROW_HIT_PREDICTOR_THRESHOLD;
     /*
      * Timing constraint handling:
      *  `next_precharge_ok_cycle_` is tRAS after an ACT
@@ -6,6 +6,8 @@
 #include "defs.h"
 #include "dram/config.h"
 
+#include <INIReader.h>
+
 #include <algorithm>
 
 #include <math.h>
@@ -54,3 +56,109 @@ fill_config_for_4400_4800_5200(DRAMConfig& conf, std::string_view which) {
 
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
+
+void
+fill_config_from_ini(DRAMConfig& conf, std::string ini_file) {
+    INIReader reader(ini_file);
+    if (reader.ParseError() < 0) {
+        std::cerr << "fill_config_from_ini: cannot read " << ini_file << ", using defaults.\n";
+        return;
+    }
+
+    conf.VDD = reader.GetReal("power", "VDD", 1.2);
+    conf.IDD0 = reader.GetReal("power", "IDD0", 57);
+    conf.IDD2N = reader.GetReal("power", "IDD2N", 37);
+    conf.IDD2P = reader.GetReal("power", "IDD2P", 25);
+    conf.IDD3N = reader.GetReal("power", "IDD3N", 52);
+    conf.IDD3P = reader.GetReal("power", "IDD3P", 43);
+    conf.IDD4R = reader.GetReal("power", "IDD4R", 168);
+    conf.IDD4W = reader.GetReal("power", "IDD4W", 150);
+    conf.IDD5AB = reader.GetReal("power", "IDD5AB", 250);
+    conf.devices_per_rank = COLUMN_WIDTH / reader.GetInteger("dram_structure", "device_width", 4);
+    conf.burst_cycles = reader.GetInteger("dram_structure", "BL", 16) / 2;
+
+    conf.powerdown_enabled = reader.GetBoolean("power", "powerdown", false);
+    conf.powerdown_idle_cycles = reader.GetInteger("power", "powerdown_idle_cycles", 64);
+    conf.tCKE = reader.GetInteger("timing", "tCKE", 8);
+    conf.tXP = reader.GetInteger("timing", "tXP", 18);
+
+    std::string page_policy = reader.Get("system", "row_buf_policy", "OPEN_PAGE");
+    if (page_policy == "OPEN_PAGE")             conf.page_policy = DRAMPagePolicy::OPEN;
+    else if (page_policy == "CLOSE_PAGE")       conf.page_policy = DRAMPagePolicy::CLOSED;
+    else if (page_policy == "SOFT_CLOSE_PAGE")  conf.page_policy = DRAMPagePolicy::SOFT_CLOSE;
+    else if (page_policy == "TIMEOUT_PAGE")     conf.page_policy = DRAMPagePolicy::TIMEOUT;
+    else if (page_policy == "PREDICTIVE_PAGE")  conf.page_policy = DRAMPagePolicy::PREDICTIVE;
+    else {
+        std::cerr << "fill_config_from_ini: unknown row buffer policy \"" << page_policy << "\".\n";
+        exit(1);
+    }
+    conf.page_timeout = reader.GetInteger("system", "page_timeout", 200);
+    conf.max_consecutive_column_accesses = reader.GetInteger("system", "max_row_hits", 4);
+
+    conf.raaimt = reader.GetInteger("rfm", "raaimt", 32);
+    conf.raammt = reader.GetInteger("rfm", "raammt", conf.raaimt*3);
+    conf.rfm_raa_decrement = reader.GetInteger("rfm", "rfm_raa_decrement", conf.raaimt);
+    conf.ref_raa_decrement = reader.GetInteger("rfm", "ref_raa_decrement", conf.raaimt/2);
+    conf.tRFM = reader.GetInteger("rfm", "tRFM", conf.tRFC);
+    conf.tRFMsb = reader.GetInteger("rfm", "tRFMsb", conf.tRFC/2);
+    conf.rfm_mode = reader.GetInteger("rfm", "rfm_mode", 0);
+
+    // `rows_refreshed` is relative to the native model's `NUM_ROWS`, not the
+    // `rows` of the *.ini file.
+    conf.alert_mode = reader.GetInteger("alert", "alert_mode", 0);
+    conf.rows_refreshed = std::max(1L, static_cast<long>(NUM_ROWS) / reader.GetInteger("alert", "refchunks", 8192));
+    conf.tABO_act = reader.GetInteger("alert", "tABO_act", 432);
+    conf.ABO_delay_acts = reader.GetInteger("alert", "ABO_delay_acts", 1);
+
+    conf.moat_mode = reader.GetInteger("moat", "moat_mode", 0);
+    conf.moatth = reader.GetInteger("moat", "moatth", 64);
+
+    conf.mirza_mode = reader.GetInteger("mirza", "mirza_mode", 0);
+    conf.mirza_groups = reader.GetInteger("mirza", "mirza_groups", 256);
+    conf.mirza_groupth = reader.GetInteger("mirza", "mirza_groupth", 1200);
+    conf.mirza_qsize = reader.GetInteger("mirza", "mirza_qsize", 4);
+    conf.mirza_qth = reader.GetInteger("mirza", "mirza_qth", 40);
+    conf.mirza_mintw = reader.GetInteger("mirza", "mirza_mintw", 8);
+
+    if (conf.mirza_groups == 0 || NUM_ROWS % conf.mirza_groups != 0) {
+        std::cerr << "fill_config_from_ini: mirza_groups (" << conf.mirza_groups 
+                    << ") must divide the number of rows (" << NUM_ROWS << ").\n";
+        exit(1);
+    }
+
+    std::string drain_mode = reader.Get("write_drain", "mode", "WATERMARK");
+    if (drain_mode == "WATERMARK")          conf.wr_drain_mode = DRAMWriteDrainMode::WATERMARK;
+    else if (drain_mode == "READ_PRIORITY") conf.wr_drain_mode = DRAMWriteDrainMode::READ_PRIORITY;
+    else {
+        std::cerr << "fill_config_from_ini: unknown write drain mode \"" << drain_mode << "\".\n";
+        exit(1);
+    }
+    conf.wr_high_watermark = reader.GetInteger("write_drain", "high_watermark", 128);
+    conf.wr_low_watermark = reader.GetInteger("write_drain", "low_watermark", 0);
+    conf.wr_opp_drain_threshold = reader.GetInteger("write_drain", "opp_drain_threshold", 8);
+    conf.wr_starvation_cycles = reader.GetInteger("write_drain", "starvation_cycles", 4096);
+
+    if (conf.wr_low_watermark >= conf.wr_high_watermark) {
+        std::cerr << "fill_config_from_ini: write drain low watermark (" << conf.wr_low_watermark
+                    << ") must be less than the high watermark (" << conf.wr_high_watermark << ").\n";
+        exit(1);
+    }
+
+    conf.tick_threads = reader.GetInteger("parallel", "tick_threads", conf.tick_threads);
+    conf.merge_quantum = reader.GetInteger("parallel", "merge_quantum", conf.merge_quantum);
+    if (conf.tick_threads == 0 || conf.merge_quantum == 0 || conf.merge_quantum > conf.CL) {
+        std::cerr << "fill_config_from_ini: need tick_threads > 0 and 0 < merge_quantum <= CL (" << conf.CL << ").\n";
+        exit(1);
+    }
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+bool
+mitigation_is_enabled(const DRAMConfig& conf) {
+    return conf.rfm_mode != 0 || conf.alert_mode != 0 || conf.moat_mode != 0 || conf.mirza_mode != 0;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
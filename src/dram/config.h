@@ -8,6 +8,7 @@
 
 #include "defs.h"
 
+#include <string>
 #include <string_view>
 
 ////////////////////////////////////////////////////////////////
@@ -49,9 +50,134 @@ struct DRAMConfig {
     size_t tRRD_S;
 
     size_t tFAW;
+    /*
+     * Power-down (see `DRAMRank::tick`): a rank without pending commands
+     * enters power-down after `powerdown_idle_cycles` idle cycles, must stay
+     * there for at least `tCKE` cycles, and cannot receive commands until
+     * `tXP` cycles after it exits.
+     * */
+    bool powerdown_enabled = false;
+    size_t powerdown_idle_cycles = 64;
+    size_t tCKE = 8;
+    size_t tXP = 18;
+    /*
+     * Energy model (see `power.h`), read from the `[power]` section of the
+     * *.ini file. Currents are in mA and `VDD` is in V.
+     *
+     * `devices_per_rank` is the number of DRAM chips per rank (i.e. bus width
+     * over device width), and `burst_cycles` is the number of cycles a burst
+     * occupies the data bus.
+     * */
+    double VDD = 1.2;
+    double IDD0 = 57;
+    double IDD2N = 37;
+    double IDD2P = 25;
+    double IDD3N = 52;
+    double IDD3P = 43;
+    double IDD4R = 168;
+    double IDD4W = 150;
+    double IDD5AB = 250;
+
+    size_t devices_per_rank = COLUMN_WIDTH / 4;
+    size_t burst_cycles = 8;
+    /*
+     * Page policy, read from `row_buf_policy` in the `[system]` section of the
+     * *.ini file (DRAMsim3's `OPEN_PAGE`, `CLOSE_PAGE`, and `SOFT_CLOSE_PAGE`,
+     * plus `TIMEOUT_PAGE` and `PREDICTIVE_PAGE`):
+     *
+     *  `OPEN`: rows are closed only on a conflict.
+     *  `CLOSED`: every column access auto-precharges.
+     *  `SOFT_CLOSE`: a column access auto-precharges unless another queued
+     *      access goes to the same row.
+     *  `TIMEOUT`: rows are closed once idle for `page_timeout` cycles.
+     *  `PREDICTIVE`: like `SOFT_CLOSE`, but the row is kept open if the bank's
+     *      hit predictor (see `DRAMBank`) expects another hit.
+     *
+     * With all policies, an open row is closed on a conflict once it has
+     * served `max_consecutive_column_accesses` accesses.
+     * */
+    DRAMPagePolicy page_policy = DRAMPagePolicy::OPEN;
+    size_t page_timeout = 200;
+    size_t max_consecutive_column_accesses = 4;
+    /*
+     * Row-hammer mitigation (see `mitigation.h`). Names and defaults follow
+     * the `[rfm]`, `[alert]`, `[moat]`, and `[mirza]` sections of DRAMsim3
+     * configs, so the same *.ini files can be used here.
+     *
+     * `rfm_mode`: 0 = off, 1 = RFMsb, 2 = RFMab when a bank's RAA counter
+     *      reaches `raammt`.
+     * `alert_mode`: 0 = off, 1 = ABO (ALERT_n is asserted when a bank asks
+     *      for it, and an RFMab is issued `tABO_act` cycles later).
+     * `rows_refreshed`: rows refreshed per bank by each REF.
+     * */
+    size_t rfm_mode = 0;
+    size_t raaimt = 32;
+    size_t raammt = 96;
+    size_t rfm_raa_decrement = 32;
+    size_t ref_raa_decrement = 16;
+    size_t tRFM = 984;
+    size_t tRFMsb = 492;
+
+    size_t alert_mode = 0;
+    size_t rows_refreshed = NUM_ROWS / 8192;
+    size_t tABO_act = 432;
+    size_t ABO_delay_acts = 1;
+
+    size_t moat_mode = 0;
+    size_t moatth = 64;
+
+    size_t mirza_mode = 0;
+    size_t mirza_groups = 256;
+    size_t mirza_groupth = 1200;
+    size_t mirza_qsize = 4;
+    size_t mirza_qth = 40;
+    size_t mirza_mintw = 8;
+    /*
+     * Write draining (see `DRAMSubchannel::schedule_next_request`). These are
+     * read from the `[write_drain]` section of the *.ini file.
+     *
+     * In `WATERMARK` mode, the subchannel switches to writes when the write
+     * buffer reaches `wr_high_watermark` (or opportunistically, when all
+     * command queues are empty and more than `wr_opp_drain_threshold` writes
+     * are buffered), and switches back at `wr_low_watermark`.
+     *
+     * `READ_PRIORITY` additionally drains whenever no reads are waiting, but
+     * yields to reads as soon as they arrive -- unless the drain was forced by
+     * the high watermark or by a write waiting `wr_starvation_cycles` or more.
+     * */
+    DRAMWriteDrainMode wr_drain_mode = DRAMWriteDrainMode::WATERMARK;
+    size_t wr_high_watermark = 128;
+    size_t wr_low_watermark = 0;
+    size_t wr_opp_drain_threshold = 8;
+    size_t wr_starvation_cycles = 4096;
+    /*
+     * Simulation parallelism (see `DRAMController`), read from the
+     * `[parallel]` section of the *.ini file.
+     *
+     * `tick_threads`: number of threads ticking subchannels. Subchannels are
+     *      ticked serially unless this is set: parallel ticking only pays off
+     *      with several channels and `merge_quantum` well above 1.
+     * `merge_quantum`: subchannels are ticked `merge_quantum` DRAM cycles at
+     *      a time, between synchronizations, and their completed reads are
+     *      merged after each quantum. Must be at most `CL` (no read can
+     *      complete sooner), so reads still return on time. Above 1, a full
+     *      queue or a write's completion is only seen at the end of a quantum.
+     * */
+    size_t tick_threads = 1;
+    size_t merge_quantum = 1;
 };
 
 void fill_config_for_4400_4800_5200(DRAMConfig&, std::string_view which="4800");
+/*
+ * Reads the power, page policy, mitigation, write drain, and parallelism
+ * parameters from a DRAMsim3 *.ini file.
+ * Must be called after `fill_config_xxx` (some defaults depend on `tRFC`).
+ * */
+void fill_config_from_ini(DRAMConfig&, std::string ini_file);
+/*
+ * Returns true if any row-hammer mitigation is enabled.
+ * */
+bool mitigation_is_enabled(const DRAMConfig&);
 
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
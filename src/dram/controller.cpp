@@ -6,6 +6,10 @@
 #include "defs.h"
 #include "cache/controller/llc2.h"
 #include "dram/controller.h"
+#include "dram/power.h"
+#include "os.h"
+
+#include <algorithm>
 
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
@@ -17,7 +21,29 @@ uint64_t GL_dram_cycle_ = 0;
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 
-DRAMController::DRAMController() {}
+DRAMController::DRAMController() {
+    // Never use more threads than the machine has.
+    size_t n_hw_threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t n_threads = std::min({GL_dram_conf_.tick_threads, N_MEM, n_hw_threads});
+    for (size_t i = 0; i <= n_threads; i++) {
+        worker_first_mem_.push_back((i*N_MEM) / n_threads);
+    }
+    // Thread 0 is the caller of `tick`.
+    for (size_t i = 1; i < n_threads; i++) {
+        workers_.emplace_back(&DRAMController::worker_loop, this, i);
+    }
+}
+
+DRAMController::~DRAMController() {
+    workers_should_exit_.store(true, std::memory_order_release);
+    release_workers();
+    for (std::thread& t : workers_) t.join();
+
+    while (!finished_reads_.empty()) {
+        delete finished_reads_.top();
+        finished_reads_.pop();
+    }
+}
 
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
@@ -25,21 +51,25 @@ DRAMController::DRAMController() {}
 void
 DRAMController::tick() {
     bool tick_mem = leap_op_ < 1.0;
-    for (size_t i = 0; i < N_MEM; i++) {
-        if (tick_mem) mem_[i].tick();
-        // Check if any requests have finished.
-        while (mem_[i].finished_reads_.size() > 0) {
-            DRAMTransaction* trans = mem_[i].finished_reads_.top();
-            if (GL_dram_cycle_ < trans->dram_cycle_finished_) {
-                break; 
-            }
-            mem_[i].finished_reads_.pop();
-            // Update LLC and stats.
+    if (tick_mem && (++dram_cycles_since_merge_) == GL_dram_conf_.merge_quantum) {
+        this->tick_mem();
+        for (size_t i = 0; i < N_MEM; i++) merge_finished_reads(i);
+        dram_cycles_since_merge_ = 0;
+    }
+    // Check if any requests have finished.
+    while (finished_reads_.size() > 0) {
+        DRAMTransaction* trans = finished_reads_.top();
+        if (GL_dram_cycle_ < trans->dram_cycle_finished_) {
+            break;
+        }
+        finished_reads_.pop();
+        // Update LLC (unless this is a page copy read) and stats.
+        if (GL_os_->tiers_ == nullptr || !GL_os_->tiers_->finish_copy_read(trans->lineaddr_)) {
             GL_llc_controller_->mark_as_finished(trans->lineaddr_);
-            s_tot_read_latency_ += GL_cycle_ - trans->cpu_cycle_added_;
-
-            delete trans;
         }
+        s_tot_read_latency_ += GL_cycle_ - trans->cpu_cycle_added_;
+
+        delete trans;
     }
     if (tick_mem) {
         leap_op_ += DRAM_CLOCK_SCALE;
@@ -57,7 +87,11 @@ DRAMController::make_request(uint64_t lineaddr, bool is_read) {
     size_t idx = CHANNEL(lineaddr) * NUM_SUBCHANNELS + SUBCHANNEL(lineaddr);
     if (is_read) ++s_num_reads_;
     else         ++s_num_writes_;
-    return mem_[idx].make_request(lineaddr, is_read);
+    bool success = mem_[idx].make_request(lineaddr, is_read);
+    // Reads forwarded from the write buffer finish immediately, so they
+    // cannot wait for the next merge.
+    if (is_read) merge_finished_reads(idx);
+    return success;
 }
 
 ////////////////////////////////////////////////////////////////
@@ -76,6 +110,90 @@ DRAMController::print_stats(std::ostream& out) {
         mem_[i].accumulate_stats_into(sc_stats);
     }
     sc_stats.print_stats(out);
+    // Energy is reported per channel.
+    for (size_t i = 0; i < NUM_CHANNELS; i++) {
+        DRAMSubchannelStats ch_stats;
+        for (size_t j = 0; j < NUM_SUBCHANNELS; j++) {
+            mem_[i*NUM_SUBCHANNELS + j].accumulate_stats_into(ch_stats);
+        }
+        DRAMEnergy(ch_stats).print_stats(out, "DRAM_CH" + std::to_string(i), GL_dram_cycle_);
+    }
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+DRAMController::tick_mem() {
+    quantum_first_cycle_ = GL_dram_cycle_+1 - GL_dram_conf_.merge_quantum;
+    if (workers_.empty()) {
+        tick_mem_range(0);
+        return;
+    }
+    num_workers_done_.store(0, std::memory_order_relaxed);
+    release_workers();
+
+    tick_mem_range(0);
+    const size_t n = workers_.size();
+    for (size_t i = 0; i < BARRIER_SPINS; i++) {
+        if (num_workers_done_.load(std::memory_order_acquire) == n) return;
+        std::this_thread::yield();
+    }
+    std::unique_lock<std::mutex> lk(barrier_mutex_);
+    done_cv_.wait(lk, [this, n] { return num_workers_done_.load(std::memory_order_acquire) == n; });
+}
+
+void
+DRAMController::tick_mem_range(size_t worker_id) {
+    for (size_t i = worker_first_mem_[worker_id]; i < worker_first_mem_[worker_id+1]; i++) {
+        for (size_t c = 0; c < GL_dram_conf_.merge_quantum; c++) {
+            mem_[i].tick(quantum_first_cycle_ + c);
+        }
+    }
+}
+
+void
+DRAMController::release_workers() {
+    {
+        std::lock_guard<std::mutex> lk(barrier_mutex_);
+        tick_epoch_.fetch_add(1, std::memory_order_release);
+    }
+    tick_cv_.notify_all();
+}
+
+void
+DRAMController::worker_loop(size_t worker_id) {
+    uint64_t epoch = 0;
+    auto released = [this, &epoch] { return tick_epoch_.load(std::memory_order_acquire) != epoch; };
+    while (true) {
+        for (size_t i = 0; i < BARRIER_SPINS && !released(); i++) {
+            std::this_thread::yield();
+        }
+        if (!released()) {
+            std::unique_lock<std::mutex> lk(barrier_mutex_);
+            tick_cv_.wait(lk, released);
+        }
+        epoch = tick_epoch_.load(std::memory_order_acquire);
+        if (workers_should_exit_.load(std::memory_order_acquire)) return;
+
+        tick_mem_range(worker_id);
+        if (num_workers_done_.fetch_add(1, std::memory_order_acq_rel)+1 == workers_.size()) {
+            std::lock_guard<std::mutex> lk(barrier_mutex_);
+            done_cv_.notify_one();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+DRAMController::merge_finished_reads(size_t mem_idx) {
+    auto& q = mem_[mem_idx].finished_reads_;
+    while (!q.empty()) {
+        finished_reads_.push(q.top());
+        q.pop();
+    }
 }
 
 ////////////////////////////////////////////////////////////////
@@ -8,6 +8,12 @@
 
 #include "dram/subchannel.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 
@@ -20,15 +26,61 @@ public:
     uint64_t s_tot_read_latency_ =0;
 private:
     DRAMSubchannel mem_[N_MEM];
+    /*
+     * Subchannels share no state, so they can be ticked in parallel. The
+     * subchannels are ticked a quantum of `merge_quantum` DRAM cycles at a
+     * time, once `GL_dram_cycle_` reaches the last cycle of the quantum. Each
+     * thread ticks a contiguous range of `mem_` through the whole quantum (the
+     * calling thread ticks the first range), and `tick_mem` returns once all
+     * threads are done. Requests made in the meantime wait in the subchannel
+     * until it reaches the cycle they were made in.
+     *
+     * Each subchannel's `finished_reads_` is its output buffer: these are
+     * merged into `finished_reads_` (below) after each quantum, and the LLC is
+     * only updated from the merged queue. No read completes sooner than `CL`
+     * after it is issued, so none is due before its quantum has been ticked.
+     *
+     * Threads waiting at either end of the barrier yield up to `BARRIER_SPINS`
+     * times and then sleep on `tick_cv_` (workers) or `done_cv_` (caller).
+     * */
+    constexpr static size_t BARRIER_SPINS = 256;
+
+    std::vector<std::thread> workers_;
+    std::vector<size_t> worker_first_mem_;
+    std::atomic<uint64_t> tick_epoch_ =0;
+    std::atomic<size_t> num_workers_done_ =0;
+    std::atomic<bool> workers_should_exit_ =false;
+    uint64_t quantum_first_cycle_ =0;
+
+    std::mutex barrier_mutex_;
+    std::condition_variable tick_cv_;
+    std::condition_variable done_cv_;
+
+    TransactionReturnQueue finished_reads_;
+    size_t dram_cycles_since_merge_ =0;
 
     double leap_op_ =0.0;
 public:
     DRAMController(void);
+    ~DRAMController(void);
 
     void tick(void);
     bool make_request(uint64_t lineaddr, bool is_read);
 
     void print_stats(std::ostream&);
+private:
+    /*
+     * Ticks every subchannel through the quantum ending at `GL_dram_cycle_`.
+     * */
+    void tick_mem(void);
+    void tick_mem_range(size_t worker_id);
+    void worker_loop(size_t worker_id);
+    /*
+     * Starts the next quantum on the workers.
+     * */
+    void release_workers(void);
+
+    void merge_finished_reads(size_t mem_idx);
 };
 
 ////////////////////////////////////////////////////////////////
@@ -0,0 +1,43 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#include "dram/config.h"
+#include "dram/mitigation.h"
+#include "dram/mitigation/mirza.h"
+#include "dram/mitigation/moat.h"
+#include "dram/mitigation/rfm.h"
+
+#include <string>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+DRAMMitigationStats::print_stats(std::ostream& out) {
+    PRINT_STAT(out, "DRAM_MITIGATIONS", s_num_mitigations_);
+    if (GL_dram_conf_.mirza_mode != 0) {
+        PRINT_STAT(out, "DRAM_MIRZA_QUEUE_INSERTS", s_num_queue_inserts_);
+    }
+    if (GL_dram_conf_.moat_mode != 0) {
+        for (size_t i = 0; i < PRAC_HISTOGRAM_BINS; i++) {
+            PRINT_STAT(out, "DRAM_PRAC_PER_TREFI_" + std::to_string(i), s_prac_per_trefi_[i]);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+std::vector<std::unique_ptr<DRAMMitigation>>
+make_mitigations() {
+    std::vector<std::unique_ptr<DRAMMitigation>> m;
+    if (GL_dram_conf_.rfm_mode != 0)    m.push_back(std::make_unique<RFMMitigation>());
+    if (GL_dram_conf_.moat_mode != 0)   m.push_back(std::make_unique<MOATMitigation>());
+    if (GL_dram_conf_.mirza_mode != 0)  m.push_back(std::make_unique<MIRZAMitigation>());
+    return m;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
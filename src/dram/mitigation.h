@@ -0,0 +1,74 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#ifndef DRAM_MITIGATION_h
+#define DRAM_MITIGATION_h
+
+#include "defs.h"
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * Geometric bins for the PRAC counter histogram (same bins as
+ * DRAMsim3's `prac_per_tREFI`): 0, 1, 2, 4, ..., 1024, >1024.
+ * */
+constexpr size_t PRAC_HISTOGRAM_BINS = 13;
+
+struct DRAMMitigationStats {
+    uint64_t s_num_mitigations_ =0;
+    uint64_t s_num_queue_inserts_ =0;
+    uint64_t s_prac_per_trefi_[PRAC_HISTOGRAM_BINS] = {};
+
+    void print_stats(std::ostream&);
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * Row-hammer mitigation plug-in. Each `DRAMRank` owns one instance of every
+ * enabled mitigation (see `make_mitigations` below), and each instance
+ * tracks per-bank state for that rank.
+ *
+ * Hooks:
+ *  `on_activate`: called after an ACT to `row` in bank (`bg`, `ba`).
+ *  `on_refresh`: called for every bank covered by a REF. `first_row` is
+ *      the first of the `GL_dram_conf_.rows_refreshed` rows refreshed.
+ *  `on_rfm`: called for every bank covered by an RFM. `all_bank` is true
+ *      for RFMab (issued on ABO or when RFMab is the RAA policy).
+ *
+ * Queries:
+ *  `blocks_activate`: true if the bank cannot receive another ACT until
+ *      it gets an RFM (i.e. RAA >= RAAMMT).
+ *  `wants_alert`: true if the bank wants the rank to assert ALERT_n.
+ * */
+class DRAMMitigation {
+public:
+    virtual ~DRAMMitigation(void) =default;
+
+    virtual void on_activate(size_t bg, size_t ba, uint64_t row) =0;
+    virtual void on_refresh(size_t bg, size_t ba, uint64_t first_row) =0;
+    virtual void on_rfm(size_t bg, size_t ba, bool all_bank) =0;
+
+    virtual bool blocks_activate(size_t bg, size_t ba) { return false; }
+    virtual bool wants_alert(size_t bg, size_t ba) { return false; }
+
+    virtual void accumulate_stats_into(DRAMMitigationStats&) =0;
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * Builds the mitigations enabled in `GL_dram_conf_`.
+ * */
+std::vector<std::unique_ptr<DRAMMitigation>> make_mitigations(void);
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+#endif  // DRAM_MITIGATION_h
@@ -0,0 +1,116 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#include "dram/config.h"
+#include "dram/mitigation/mirza.h"
+
+#include <algorithm>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+MIRZAMitigation::MIRZAMitigation()
+    :group_size_(NUM_ROWS / GL_dram_conf_.mirza_groups),
+    rng_(GL_RNG_())
+{
+    for (size_t i = 0; i < NUM_BANKGROUPS; i++) {
+        for (size_t j = 0; j < NUM_BANKS; j++) {
+            banks_[i][j].gct_.assign(GL_dram_conf_.mirza_groups, 0);
+            banks_[i][j].queue_.reserve(GL_dram_conf_.mirza_qsize);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+MIRZAMitigation::on_activate(size_t bg, size_t ba, uint64_t row) {
+    MIRZABankState& b = banks_[bg][ba];
+
+    size_t group = row / group_size_;
+    ++b.gct_[group];
+    // Only sample ACTs to groups over the threshold.
+    if (group == b.curr_group_) {
+        if (++b.curr_gct_ <= GL_dram_conf_.mirza_groupth) return;
+    } else if (b.gct_[group] <= GL_dram_conf_.mirza_groupth) {
+        return;
+    }
+
+    auto it = b.index_.find(row);
+    if (it != b.index_.end()) {
+        ++b.queue_[it->second].act_ctr_;
+        return;
+    }
+    // Insert with probability 1/mintw.
+    constexpr uint64_t RES = 1L << 20;
+    if ( MOD_BY_POW2(rng_(), RES) * GL_dram_conf_.mirza_mintw < RES ) {
+        b.index_[row] = b.queue_.size();
+        b.queue_.push_back((MIRZAQueueEntry) {row, group, 1});
+        ++s_num_queue_inserts_;
+    }
+}
+
+void
+MIRZAMitigation::on_refresh(size_t bg, size_t ba, uint64_t first_row) {
+    MIRZABankState& b = banks_[bg][ba];
+    if (first_row % group_size_ != 0) return;
+
+    size_t group = first_row / group_size_;
+    b.curr_group_ = group;
+    b.curr_gct_ = b.gct_[group];
+    b.gct_[group] = 0;
+
+    auto new_end = std::remove_if(b.queue_.begin(), b.queue_.end(),
+                            [group] (const MIRZAQueueEntry& e) { return e.group_ == group; });
+    if (new_end != b.queue_.end()) {
+        b.queue_.erase(new_end, b.queue_.end());
+        reindex(b);
+    }
+}
+
+void
+MIRZAMitigation::on_rfm(size_t bg, size_t ba, bool all_bank) {
+    MIRZABankState& b = banks_[bg][ba];
+    // Only RFMab (i.e. from ABO) mitigates rows.
+    if (!all_bank || b.queue_.empty()) return;
+
+    auto it = std::max_element(b.queue_.begin(), b.queue_.end(),
+                            [] (const MIRZAQueueEntry& x, const MIRZAQueueEntry& y) { return x.act_ctr_ < y.act_ctr_; });
+    b.queue_.erase(it);
+    reindex(b);
+    ++s_num_mitigations_;
+}
+
+void
+MIRZAMitigation::reindex(MIRZABankState& b) {
+    b.index_.clear();
+    for (size_t i = 0; i < b.queue_.size(); i++) {
+        b.index_[ b.queue_[i].row_ ] = i;
+    }
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+bool
+MIRZAMitigation::wants_alert(size_t bg, size_t ba) {
+    MIRZABankState& b = banks_[bg][ba];
+    if (b.queue_.size() >= GL_dram_conf_.mirza_qsize) return true;
+    return std::any_of(b.queue_.begin(), b.queue_.end(),
+                        [] (const MIRZAQueueEntry& e) { return e.act_ctr_ >= GL_dram_conf_.mirza_qth; });
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+MIRZAMitigation::accumulate_stats_into(DRAMMitigationStats& st) {
+    st.s_num_mitigations_ += s_num_mitigations_;
+    st.s_num_queue_inserts_ += s_num_queue_inserts_;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
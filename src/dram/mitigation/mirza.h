@@ -0,0 +1,77 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#ifndef DRAM_MITIGATION_MIRZA_h
+#define DRAM_MITIGATION_MIRZA_h
+
+#include "dram/mitigation.h"
+
+#include <unordered_map>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * MIRZA: rows are split into `mirza_groups` groups, each with a group
+ * activation counter (GCT). Once a group's GCT exceeds `mirza_groupth`, ACTs
+ * to that group are sampled (with probability 1/`mirza_mintw`) into a small
+ * per-bank queue, which tracks per-row activation counts. The bank asks for
+ * an alert when the queue is full or any entry reaches `mirza_qth`. An RFMab
+ * mitigates the entry with the highest count.
+ *
+ * REFs walk through the groups: when a REF reaches the start of a group, the
+ * group's GCT is reset (its old value is kept as the "current" group count)
+ * and its queue entries are dropped.
+ *
+ * `queue_` is kept in insertion order (ties for the RFM go to the oldest
+ * entry), and `index_` maps each queued row to its position in `queue_`.
+ * */
+struct MIRZAQueueEntry {
+    uint64_t row_;
+    size_t   group_;
+    size_t   act_ctr_;
+};
+
+struct MIRZABankState {
+    std::vector<size_t>             gct_;
+    std::vector<MIRZAQueueEntry>    queue_;
+    std::unordered_map<uint64_t, size_t> index_;
+    size_t                          curr_group_ =0;
+    size_t                          curr_gct_ =0;
+};
+
+class MIRZAMitigation : public DRAMMitigation {
+private:
+    MIRZABankState banks_[NUM_BANKGROUPS][NUM_BANKS];
+    size_t group_size_;
+    /*
+     * Each instance has its own generator (seeded from `GL_RNG_`) since
+     * subchannels may be ticked in parallel (see `DRAMController`).
+     * */
+    std::mt19937_64 rng_;
+
+    uint64_t s_num_mitigations_ =0;
+    uint64_t s_num_queue_inserts_ =0;
+public:
+    MIRZAMitigation(void);
+
+    void on_activate(size_t bg, size_t ba, uint64_t row) override;
+    void on_refresh(size_t bg, size_t ba, uint64_t first_row) override;
+    void on_rfm(size_t bg, size_t ba, bool all_bank) override;
+
+    bool wants_alert(size_t bg, size_t ba) override;
+
+    void accumulate_stats_into(DRAMMitigationStats&) override;
+private:
+    /*
+     * Rebuilds `index_` after entries are removed from `queue_`.
+     * */
+    void reindex(MIRZABankState&);
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+#endif  // DRAM_MITIGATION_MIRZA_h
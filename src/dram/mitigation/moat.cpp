@@ -0,0 +1,113 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#include "dram/config.h"
+#include "dram/mitigation/moat.h"
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+inline size_t
+prac_histogram_bin(uint16_t x) {
+    if (x == 0) return 0;
+    size_t b = 1;
+    for (uint32_t lim = 1; b < PRAC_HISTOGRAM_BINS-1 && x > lim; lim <<= 1) {
+        ++b;
+    }
+    return b;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+MOATMitigation::MOATMitigation() {
+    for (size_t i = 0; i < NUM_BANKGROUPS; i++) {
+        for (size_t j = 0; j < NUM_BANKS; j++) {
+            max_row_[i][j] = -1;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+MOATMitigation::on_activate(size_t bg, size_t ba, uint64_t row) {
+    auto& prac = prac_[bg][ba];
+    int64_t& max_row = max_row_[bg][ba];
+
+    uint16_t ctr = ++prac[row];
+    if (max_row == -1 || ctr > get_prac(bg, ba, max_row)) {
+        max_row = row;
+    }
+}
+
+void
+MOATMitigation::on_refresh(size_t bg, size_t ba, uint64_t first_row) {
+    auto& prac = prac_[bg][ba];
+    int64_t& max_row = max_row_[bg][ba];
+
+    for (size_t i = 0; i < GL_dram_conf_.rows_refreshed; i++) {
+        auto it = prac.find( (first_row+i) % NUM_ROWS );
+        if (it == prac.end()) {
+            ++s_prac_per_trefi_[0];
+        } else {
+            ++s_prac_per_trefi_[ prac_histogram_bin(it->second) ];
+            prac.erase(it);
+        }
+    }
+    // The refreshed rows may wrap past the last row.
+    if (max_row != -1 
+        && (static_cast<uint64_t>(max_row) + NUM_ROWS - first_row) % NUM_ROWS < GL_dram_conf_.rows_refreshed)
+    {
+        max_row = -1;
+    }
+}
+
+void
+MOATMitigation::on_rfm(size_t bg, size_t ba, bool all_bank) {
+    auto& prac = prac_[bg][ba];
+    int64_t& max_row = max_row_[bg][ba];
+    // Only RFMab (i.e. from ABO) mitigates rows.
+    if (!all_bank || max_row == -1) return;
+
+    prac.erase(max_row);
+    if (max_row > 0) ++prac[max_row-1];
+    if (max_row > 1) ++prac[max_row-2];
+    if (max_row < static_cast<int64_t>(NUM_ROWS-1)) ++prac[max_row+1];
+    if (max_row < static_cast<int64_t>(NUM_ROWS-2)) ++prac[max_row+2];
+
+    max_row = -1;
+    ++s_num_mitigations_;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+bool
+MOATMitigation::wants_alert(size_t bg, size_t ba) {
+    int64_t max_row = max_row_[bg][ba];
+    return max_row != -1 && get_prac(bg, ba, max_row) > GL_dram_conf_.moatth;
+}
+
+uint16_t
+MOATMitigation::get_prac(size_t bg, size_t ba, uint64_t row) {
+    auto it = prac_[bg][ba].find(row);
+    return it == prac_[bg][ba].end() ? 0 : it->second;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+MOATMitigation::accumulate_stats_into(DRAMMitigationStats& st) {
+    st.s_num_mitigations_ += s_num_mitigations_;
+    for (size_t i = 0; i < PRAC_HISTOGRAM_BINS; i++) {
+        st.s_prac_per_trefi_[i] += s_prac_per_trefi_[i];
+    }
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
@@ -0,0 +1,54 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#ifndef DRAM_MITIGATION_MOAT_h
+#define DRAM_MITIGATION_MOAT_h
+
+#include "dram/mitigation.h"
+
+#include <unordered_map>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * MOAT: PRAC (one activation counter per row) + ABO. Each bank tracks the
+ * row with the highest counter since the last mitigation, and asks for an
+ * alert once that counter exceeds `moatth`. An RFMab mitigates the tracked
+ * row: its counter is reset and the counters of the two rows on either side
+ * are incremented (the victim refreshes count as activations).
+ *
+ * REFs reset the counters of the refreshed rows.
+ *
+ * Only nonzero counters are stored (`prac_` maps a row to its counter), since
+ * a bank only activates a small fraction of its rows between refreshes.
+ * */
+class MOATMitigation : public DRAMMitigation {
+private:
+    std::unordered_map<uint64_t, uint16_t> prac_[NUM_BANKGROUPS][NUM_BANKS];
+    /*
+     * `max_row_ == -1` means no row is tracked.
+     * */
+    int64_t max_row_[NUM_BANKGROUPS][NUM_BANKS];
+
+    uint64_t s_num_mitigations_ =0;
+    uint64_t s_prac_per_trefi_[PRAC_HISTOGRAM_BINS] = {};
+public:
+    MOATMitigation(void);
+
+    void on_activate(size_t bg, size_t ba, uint64_t row) override;
+    void on_refresh(size_t bg, size_t ba, uint64_t first_row) override;
+    void on_rfm(size_t bg, size_t ba, bool all_bank) override;
+
+    bool wants_alert(size_t bg, size_t ba) override;
+
+    void accumulate_stats_into(DRAMMitigationStats&) override;
+private:
+    uint16_t get_prac(size_t bg, size_t ba, uint64_t row);
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+#endif  // DRAM_MITIGATION_MOAT_h
@@ -0,0 +1,40 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#include "dram/config.h"
+#include "dram/mitigation/rfm.h"
+
+#include <algorithm>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+RFMMitigation::on_activate(size_t bg, size_t ba, uint64_t row) {
+    ++raa_ctr_[bg][ba];
+}
+
+void
+RFMMitigation::on_refresh(size_t bg, size_t ba, uint64_t first_row) {
+    uint64_t& ctr = raa_ctr_[bg][ba];
+    ctr -= std::min<uint64_t>(ctr, GL_dram_conf_.ref_raa_decrement);
+}
+
+void
+RFMMitigation::on_rfm(size_t bg, size_t ba, bool all_bank) {
+    uint64_t& ctr = raa_ctr_[bg][ba];
+    ctr -= std::min<uint64_t>(ctr, GL_dram_conf_.rfm_raa_decrement);
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+bool
+RFMMitigation::blocks_activate(size_t bg, size_t ba) {
+    return raa_ctr_[bg][ba] >= GL_dram_conf_.raammt;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
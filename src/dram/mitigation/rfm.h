@@ -0,0 +1,35 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#ifndef DRAM_MITIGATION_RFM_h
+#define DRAM_MITIGATION_RFM_h
+
+#include "dram/mitigation.h"
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * Rolling Accumulated ACT (RAA) counters: every ACT increments the bank's
+ * counter, and once it reaches RAAMMT the bank is blocked from further ACTs
+ * until it receives an RFM (RFMsb or RFMab, depending on `rfm_mode`). REFs
+ * and RFMs decrement the counter.
+ * */
+class RFMMitigation : public DRAMMitigation {
+private:
+    uint64_t raa_ctr_[NUM_BANKGROUPS][NUM_BANKS] = {};
+public:
+    void on_activate(size_t bg, size_t ba, uint64_t row) override;
+    void on_refresh(size_t bg, size_t ba, uint64_t first_row) override;
+    void on_rfm(size_t bg, size_t ba, bool all_bank) override;
+
+    bool blocks_activate(size_t bg, size_t ba) override;
+
+    void accumulate_stats_into(DRAMMitigationStats&) override {}
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+#endif  // DRAM_MITIGATION_RFM_h
@@ -0,0 +1,61 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#include "dram/config.h"
+#include "dram/power.h"
+#include "dram/subchannel.h"
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+DRAMEnergy::DRAMEnergy(const DRAMSubchannelStats& st) {
+    const DRAMConfig& conf = GL_dram_conf_;
+    // Scale from mA * V * cycles to pJ.
+    const double scale = conf.VDD * conf.devices_per_rank * conf.tCK;
+    const double tRFMsb_eff = static_cast<double>(conf.tRFMsb) / NUM_BANKS;
+
+    double e_act = (conf.IDD0 - conf.IDD3N) * conf.tRAS,
+           e_pre = (conf.IDD0 - conf.IDD2N) * conf.tRP,
+           e_rd = (conf.IDD4R - conf.IDD3N) * conf.burst_cycles,
+           e_wr = (conf.IDD4W - conf.IDD3N) * conf.burst_cycles,
+           e_ref_per_cycle = conf.IDD5AB - conf.IDD3N;
+
+    act_ = scale * e_act * st.s_num_acts_;
+    pre_ = scale * e_pre * st.s_num_pre_;
+    read_ = scale * e_rd * st.s_num_read_cmds_;
+    write_ = scale * e_wr * st.s_num_write_cmds_;
+    // RFMsb only refreshes one bank per bankgroup.
+    ref_ = scale * e_ref_per_cycle * ( st.s_num_refs_ * conf.tRFC 
+                                        + st.s_num_rfm_ab_ * conf.tRFM
+                                        + st.s_num_rfm_sb_ * tRFMsb_eff );
+    background_ = scale * ( conf.IDD3N * st.s_act_stb_cycles_
+                            + conf.IDD2N * st.s_pre_stb_cycles_
+                            + conf.IDD3P * st.s_act_pd_cycles_
+                            + conf.IDD2P * st.s_pre_pd_cycles_ );
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+double
+DRAMEnergy::total() const {
+    return act_ + pre_ + read_ + write_ + ref_ + background_;
+}
+
+void
+DRAMEnergy::print_stats(std::ostream& out, std::string_view header, uint64_t dram_cycles) const {
+    PRINT_STAT(out, header, "ACT_ENERGY_NJ", act_*1e-3);
+    PRINT_STAT(out, header, "PRE_ENERGY_NJ", pre_*1e-3);
+    PRINT_STAT(out, header, "READ_ENERGY_NJ", read_*1e-3);
+    PRINT_STAT(out, header, "WRITE_ENERGY_NJ", write_*1e-3);
+    PRINT_STAT(out, header, "REF_ENERGY_NJ", ref_*1e-3);
+    PRINT_STAT(out, header, "BG_ENERGY_NJ", background_*1e-3);
+    PRINT_STAT(out, header, "TOTAL_ENERGY_NJ", total()*1e-3);
+    // pJ/ns = mW
+    PRINT_STAT(out, header, "AVG_POWER_MW", total() / (dram_cycles * GL_dram_conf_.tCK));
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
@@ -0,0 +1,54 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#ifndef DRAM_POWER_h
+#define DRAM_POWER_h
+
+#include "defs.h"
+
+#include <iostream>
+#include <string_view>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+struct DRAMSubchannelStats;
+
+/*
+ * IDD-based energy model (as in DRAMsim3 and the Micron power calculator).
+ * All energies are in pJ:
+ *
+ *  ACT:    VDD * (IDD0 - IDD3N) * tRAS
+ *  PRE:    VDD * (IDD0 - IDD2N) * tRP   (so ACT + PRE covers IDD0 over tRC)
+ *  RD/WR:  VDD * (IDD4R/W - IDD3N) * burst_cycles
+ *  REF:    VDD * (IDD5AB - IDD3N) * tRFC  (RFMs scale this by tRFM/tRFC)
+ *
+ * Background energy is VDD * IDDx per cycle in each rank state: IDD3N
+ * (active standby), IDD2N (precharged standby), IDD3P (active power-down),
+ * and IDD2P (precharged power-down).
+ *
+ * Everything is multiplied by `devices_per_rank` and `tCK`.
+ * */
+struct DRAMEnergy {
+    double act_ =0.0;
+    double pre_ =0.0;
+    double read_ =0.0;
+    double write_ =0.0;
+    double ref_ =0.0;
+    double background_ =0.0;
+
+    DRAMEnergy(const DRAMSubchannelStats&);
+
+    double total(void) const;
+    /*
+     * Prints energy (in nJ) and the average power over `dram_cycles` (in mW).
+     * */
+    void print_stats(std::ostream&, std::string_view header, uint64_t dram_cycles) const;
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+#endif  // DRAM_POWER_h
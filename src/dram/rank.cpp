@@ -5,6 +5,8 @@
 #include "dram/rank.h"
 #include "utils/bitcount.h"
 
+#include <algorithm>
+
 #include <string.h>
 
 ////////////////////////////////////////////////////////////////
@@ -27,105 +29,206 @@ DRAMRank::DRAMRank()
     memset(next_row_activate_ok_cycle_, 0, 2*sizeof(uint64_t));
     memset(next_column_read_ok_cycle_, 0, 2*sizeof(uint64_t));
     memset(next_column_write_ok_cycle_, 0, 2*sizeof(uint64_t));
+
+    mitigations_ = make_mitigations();
 }
 
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 
 void
-DRAMRank::tick() {
+DRAMRank::tick(uint64_t dram_cycle) {
+    dram_cycle_ = dram_cycle;
+    update_powerdown_state();
     // Check if we need to do a refresh.
     if (is_waiting_to_do_ref_) {
-        if (GL_dram_cycle_ >= any_bank_busy_until_dram_cycle_) {
+        if (is_awake() && dram_cycle_ >= any_bank_busy_until_dram_cycle_) {
             issue_refresh();
             is_waiting_to_do_ref_ = false;
         }
+    } else if (has_pending_rfm()) {
+        if (is_awake() && dram_cycle_ >= any_bank_busy_until_dram_cycle_) {
+            issue_rfm();
+        }
+    }
+    // ABO: the memory controller gets `tABO_act` cycles before it must issue an RFMab.
+    if (alert_n_ && dram_cycle_ > last_alert_dram_cycle_ + GL_dram_conf_.tABO_act) {
+        alert_n_ = false;
+        needs_rfm_ab_ = true;
     }
     // Update FAW.
     while (!last_four_act_dram_cycles_.empty() 
-            && GL_dram_cycle_ >= last_four_act_dram_cycles_.front() + GL_dram_conf_.tFAW) 
+            && dram_cycle_ >= last_four_act_dram_cycles_.front() + GL_dram_conf_.tFAW) 
     {
         last_four_act_dram_cycles_.pop_front();
     }
+    // Update background power stats.
+    if (is_powered_down_) {
+        if (num_open_banks_ > 0)    ++s_act_pd_cycles_;
+        else                        ++s_pre_pd_cycles_;
+    } else {
+        if (num_open_banks_ > 0)    ++s_act_stb_cycles_;
+        else                        ++s_pre_stb_cycles_;
+    }
+}
+
+void
+DRAMRank::update_powerdown_state() {
+    if (!GL_dram_conf_.powerdown_enabled) return;
+
+    bool has_work = num_cmds_ > 0 || is_waiting_to_do_ref_ || alert_n_ || has_pending_rfm();
+    if (is_powered_down_) {
+        if (has_work && dram_cycle_ >= powerdown_entry_dram_cycle_ + GL_dram_conf_.tCKE) {
+            is_powered_down_ = false;
+            powerdown_exit_done_dram_cycle_ = dram_cycle_ + GL_dram_conf_.tXP;
+        }
+    } else if (!has_work 
+                && dram_cycle_ >= any_bank_busy_until_dram_cycle_
+                && dram_cycle_ >= last_cmd_dram_cycle_ + GL_dram_conf_.powerdown_idle_cycles) 
+    {
+        is_powered_down_ = true;
+        powerdown_entry_dram_cycle_ = dram_cycle_;
+        ++s_num_powerdowns_;
+    }
 }
 
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 
+inline void
+update_row_hit_predictor(DRAMBank& bank, bool hit) {
+    if (hit && bank.row_hit_predictor_ < DRAMBank::ROW_HIT_PREDICTOR_MAX) ++bank.row_hit_predictor_;
+    if (!hit && bank.row_hit_predictor_ > 0)                              --bank.row_hit_predictor_;
+}
+
 bool
-check_for_row_hit(const DRAMBank& bank, CommandQueue::iterator from, CommandQueue::iterator end) {
+check_for_row_hit(int64_t row, CommandQueue::iterator from, CommandQueue::iterator end) {
     for (auto it = std::next(from,1); it != end; it++) {
-        if (ROW(it->lineaddr_) == bank.open_row_) return true;
+        if (static_cast<int64_t>(ROW(it->lineaddr_)) == row) return true;
     }
     return false;
 }
 
 bool
 DRAMRank::select_command(DRAMCommand& cmd) {
-    if (is_waiting_to_do_ref_) return false;
+    if (is_waiting_to_do_ref_ || needs_rfm_ab_ || !is_awake()) return false;
 
     for (size_t ii = 0; ii < N_CMD_QUEUES; ii++) {
-        size_t ba = next_cmd_queue_idx_ & (NUM_BANKS-1),
-               bg = next_cmd_queue_idx_ >> Log2<NUM_BANKS>::value;
+        size_t ba = FastDiv<NUM_BANKS>::mod(next_cmd_queue_idx_),
+               bg = FastDiv<NUM_BANKS>::div(next_cmd_queue_idx_);
         DRAMBank& bank = banks_[bg][ba];
         CommandQueue& cq = cmd_queues_[next_cmd_queue_idx_];
-        next_cmd_queue_idx_ = INCREMENT_AND_MOD_BY_POW2(next_cmd_queue_idx_, CMD_QUEUE_SIZE);
+        if (++next_cmd_queue_idx_ == N_CMD_QUEUES) {
+            next_cmd_queue_idx_ = 0;
+        }
 
-        if (GL_dram_cycle_ < bank.busy_with_ref_until_dram_cycle_ || cq.empty()) {
+        if (dram_cycle_ < bank.busy_with_ref_until_dram_cycle_ || cq.empty() || needs_rfm_sb_[ba]) {
             continue;
         }
 
         std::unordered_set<uint64_t> lineaddr_with_reads;
         for (auto it = cq.begin(); it != cq.end(); it++) {
             uint64_t r = ROW(it->lineaddr_);
+            cmd.lineaddr_ = it->lineaddr_;
             if (r == bank.open_row_) {
                 // If this is a read, then check for WAR dependence.
-                if (it->cmd_type_ == WRITE_CMD() && lineaddr_with_reads.count(it->lineaddr_)) {
+                if (it->cmd_type_ == DRAMCommandType::WRITE && lineaddr_with_reads.count(it->lineaddr_)) {
                     continue;
                 }
-                cmd = *it;
+                cmd.cmd_type_ = it->cmd_type_;
+                if (should_close_row_after(bank, it, cq.end())) {
+                    cmd.cmd_type_ = (cmd.cmd_type_ == DRAMCommandType::READ) 
+                                        ? DRAMCommandType::READ_PRECHARGE : DRAMCommandType::WRITE_PRECHARGE;
+                }
             } else {
-                if constexpr (DRAM_PAGE_POLICY == DRAMPagePolicy::OPEN) {
-                    lineaddr_with_recent_row_miss_.insert(it->lineaddr_);
-
-                    cmd.lineaddr_ = it->lineaddr_;
-                    if (bank.open_row_ == -1) {  // Empty row buffer: just issue activate.
-                        cmd.cmd_type_ = DRAMCommandType::ACTIVATE;
-                    } else {
-                        // Precharge needs to meet several conditions.
-                        if ( it != cq.begin()
-                            || (check_for_row_hit(bank, it, cq.end()) && bank.consecutive_column_accesses_ < 4) )
-                        {
-                            continue;
-                        }
-                        cmd.cmd_type_ = DRAMCommandType::PRECHARGE;
-                    }
-                } else {
-                    // In a close-page policy: this is always an ACT.
-                    cmd.lineaddr_ = it->lineaddr_;
+                lineaddr_with_recent_row_miss_.insert(it->lineaddr_);
+                if (bank.open_row_ == -1) {  // Empty row buffer: just issue activate.
                     cmd.cmd_type_ = DRAMCommandType::ACTIVATE;
+                } else {
+                    // Precharge needs to meet several conditions.
+                    if ( it != cq.begin()
+                        || (check_for_row_hit(bank.open_row_, it, cq.end()) 
+                            && bank.consecutive_column_accesses_ < GL_dram_conf_.max_consecutive_column_accesses) )
+                    {
+                        continue;
+                    }
+                    cmd.cmd_type_ = DRAMCommandType::PRECHARGE;
                 }
             }
             // Return if this command can be executed.
             if (can_execute_command(cmd)) {
-                if (cmd.cmd_type_ == READ_CMD() || cmd.cmd_type_ == WRITE_CMD()) {
+                if (cmd.cmd_type_ == DRAMCommandType::ACTIVATE && activate_needs_rfm(bg, ba)) {
+                    break;
+                }
+                if (is_column_command(cmd.cmd_type_)) {
+                    uint64_t lineaddr = it->lineaddr_;
                     cq.erase(it);
                     --num_cmds_;
-                    if constexpr (DRAM_PAGE_POLICY == DRAMPagePolicy::OPEN) {
-                        if (!lineaddr_with_recent_row_miss_.count(it->lineaddr_)) ++s_row_buf_hits_;
-                        lineaddr_with_recent_row_miss_.erase(it->lineaddr_);
+                    if (!lineaddr_with_recent_row_miss_.count(lineaddr)) {
+                        ++s_row_buf_hits_;
+                        update_row_hit_predictor(bank, true);
                     }
+                    lineaddr_with_recent_row_miss_.erase(lineaddr);
                 } else if (cmd.cmd_type_ == DRAMCommandType::PRECHARGE) {
                     ++s_num_pre_demand_;
                 }
                 return true;
             }
 
-            if (cmd.cmd_type_ == READ_CMD()) {
+            if (it->cmd_type_ == DRAMCommandType::READ) {
                 lineaddr_with_reads.insert(it->lineaddr_);
             }
         }
     } 
+    // If nothing else can be done, close any rows that have timed out.
+    if (GL_dram_conf_.page_policy == DRAMPagePolicy::TIMEOUT) {
+        return select_timeout_precharge(cmd);
+    }
+    return false;
+}
+
+bool
+DRAMRank::should_close_row_after(const DRAMBank& bank, CommandQueue::iterator it, CommandQueue::iterator end) {
+    switch (GL_dram_conf_.page_policy) {
+        case DRAMPagePolicy::CLOSED:
+            return true;
+
+        case DRAMPagePolicy::SOFT_CLOSE:
+            return !check_for_row_hit(bank.open_row_, it, end);
+
+        case DRAMPagePolicy::PREDICTIVE:
+            return !check_for_row_hit(bank.open_row_, it, end) 
+                        && bank.row_hit_predictor_ < DRAMBank::ROW_HIT_PREDICTOR_THRESHOLD;
+
+        default:
+            return false;
+    }
+}
+
+bool
+DRAMRank::select_timeout_precharge(DRAMCommand& cmd) {
+    for (size_t i = 0; i < NUM_BANKGROUPS; i++) {
+        for (size_t j = 0; j < NUM_BANKS; j++) {
+            const DRAMBank& bank = banks_[i][j];
+            if (bank.open_row_ == -1 
+                || dram_cycle_ < bank.last_access_dram_cycle_ + GL_dram_conf_.page_timeout
+                || needs_rfm_sb_[j])
+            {
+                continue;
+            }
+            CommandQueue& cq = get_command_queue(i, j);
+            auto it = std::find_if(cq.begin(), cq.end(),
+                        [&bank] (const DRAMCommand& c) { return static_cast<int64_t>(ROW(c.lineaddr_)) == bank.open_row_; });
+            if (it != cq.end()) continue;
+
+            cmd.lineaddr_ = bank.open_lineaddr_;
+            cmd.cmd_type_ = DRAMCommandType::PRECHARGE;
+            if (can_execute_command(cmd)) {
+                ++s_num_pre_timeout_;
+                return true;
+            }
+        }
+    }
     return false;
 }
 
@@ -135,29 +238,29 @@ DRAMRank::select_command(DRAMCommand& cmd) {
 bool
 DRAMRank::can_execute_command(const DRAMCommand& cmd) {
     DRAMBank& bank = banks_[ BANKGROUP(cmd.lineaddr_) ][ BANK(cmd.lineaddr_) ];
-    if (GL_dram_cycle_ < bank.busy_with_ref_until_dram_cycle_) {
+    if (dram_cycle_ < bank.busy_with_ref_until_dram_cycle_) {
         return false;
     }
     // Get same-bankgroup/diff-bankgroup index. 
     size_t sbg = (last_bankgroup_used_ == BANKGROUP(cmd.lineaddr_)) ? 1 : 0;
     // Check if tCCD timings are met:
-    bool read_is_ok = GL_dram_cycle_ >= next_column_read_ok_cycle_[sbg];
-    bool write_is_ok = GL_dram_cycle_ >= next_column_write_ok_cycle_[sbg];
+    bool read_is_ok = dram_cycle_ >= next_column_read_ok_cycle_[sbg];
+    bool write_is_ok = dram_cycle_ >= next_column_write_ok_cycle_[sbg];
     // Check if row buffer contains row and tCCD/tRCD timings are met.
     bool read_write_is_ok = 
             bank.open_row_ == ROW(cmd.lineaddr_) 
-                && GL_dram_cycle_ >= bank.next_column_access_ok_cycle_
-                && ( (cmd.cmd_type_ == DRAMCommandType::READ && read_is_ok) 
+                && dram_cycle_ >= bank.next_column_access_ok_cycle_
+                && ( (is_read_command(cmd.cmd_type_) && read_is_ok) 
                         || 
-                     (cmd.cmd_type_ == DRAMCommandType::WRITE && write_is_ok) );
+                     (is_write_command(cmd.cmd_type_) && write_is_ok) );
     // Check if tRAS timing is met
     bool precharge_is_ok = 
-            bank.open_row_ >= 0 && GL_dram_cycle_ >= bank.next_precharge_ok_cycle_;
+            bank.open_row_ >= 0 && dram_cycle_ >= bank.next_precharge_ok_cycle_;
     // Check if tRP/tRRD/tFAW timing is met
     bool activate_is_ok = 
             bank.open_row_ == -1 
-                && GL_dram_cycle_ >= bank.next_activate_ok_cycle_ 
-                && GL_dram_cycle_ >= next_row_activate_ok_cycle_[sbg]
+                && dram_cycle_ >= bank.next_activate_ok_cycle_ 
+                && dram_cycle_ >= next_row_activate_ok_cycle_[sbg]
                 && last_four_act_dram_cycles_.size() < 4;
     // Now return based on above:
     switch (cmd.cmd_type_) {
@@ -184,26 +287,30 @@ DRAMRank::can_execute_command(const DRAMCommand& cmd) {
 ////////////////////////////////////////////////////////////////
 
 inline void
-update_timing(uint64_t* con, uint64_t t_s, uint64_t t_l) {
-    con[0] = GL_dram_cycle_ + t_s;
-    con[1] = GL_dram_cycle_ + t_l;
+update_timing(uint64_t* con, uint64_t dram_cycle, uint64_t t_s, uint64_t t_l) {
+    con[0] = dram_cycle + t_s;
+    con[1] = dram_cycle + t_l;
 }
 
 uint64_t
 DRAMRank::execute_command(const DRAMCommand& cmd) {
-    DRAMBank& bank = banks_[ BANKGROUP(cmd.lineaddr_) ][ BANK(cmd.lineaddr_) ];
+    size_t bg = BANKGROUP(cmd.lineaddr_),
+           ba = BANK(cmd.lineaddr_);
+    DRAMBank& bank = banks_[bg][ba];
     // We are assuming all timing constraints have been met.
     uint64_t latency = 0;
     switch (cmd.cmd_type_) {
         case DRAMCommandType::READ_PRECHARGE:
             bank.open_row_ = -1;
-            bank.next_activate_ok_cycle_ = GL_dram_cycle_ + GL_dram_conf_.tRP;
+            bank.next_activate_ok_cycle_ = dram_cycle_ + GL_dram_conf_.tRP;
+            bank.consecutive_column_accesses_ = 0;
+            --num_open_banks_;
             ++s_num_pre_;
         case DRAMCommandType::READ:
             latency += GL_dram_conf_.CL + BL/2;
             // Update timing constraints.
-            update_timing(next_column_read_ok_cycle_, GL_dram_conf_.tCCD_S, GL_dram_conf_.tCCD_L);
-            update_timing(next_column_write_ok_cycle_, GL_dram_conf_.tCCD_S_RTW, GL_dram_conf_.tCCD_L_RTW);
+            update_timing(next_column_read_ok_cycle_, dram_cycle_, GL_dram_conf_.tCCD_S, GL_dram_conf_.tCCD_L);
+            update_timing(next_column_write_ok_cycle_, dram_cycle_, GL_dram_conf_.tCCD_S_RTW, GL_dram_conf_.tCCD_L_RTW);
             ++s_num_read_cmds_;
             if (cmd.cmd_type_ == DRAMCommandType::READ) {
                 ++bank.consecutive_column_accesses_;
@@ -212,13 +319,15 @@ DRAMRank::execute_command(const DRAMCommand& cmd) {
 
         case DRAMCommandType::WRITE_PRECHARGE:
             bank.open_row_ = -1;
-            bank.next_activate_ok_cycle_ = GL_dram_cycle_ + GL_dram_conf_.tRP;
+            bank.next_activate_ok_cycle_ = dram_cycle_ + GL_dram_conf_.tRP;
+            bank.consecutive_column_accesses_ = 0;
+            --num_open_banks_;
             ++s_num_pre_;
         case DRAMCommandType::WRITE:
             latency += GL_dram_conf_.CWL + BL/2;
             // Update timing constraints.
-            update_timing(next_column_read_ok_cycle_, GL_dram_conf_.tCCD_S_WTR, GL_dram_conf_.tCCD_L_WTR);
-            update_timing(next_column_write_ok_cycle_, GL_dram_conf_.tCCD_S_WR, GL_dram_conf_.tCCD_L_WR);
+            update_timing(next_column_read_ok_cycle_, dram_cycle_, GL_dram_conf_.tCCD_S_WTR, GL_dram_conf_.tCCD_L_WTR);
+            update_timing(next_column_write_ok_cycle_, dram_cycle_, GL_dram_conf_.tCCD_S_WR, GL_dram_conf_.tCCD_L_WR);
             ++s_num_write_cmds_;
             if (cmd.cmd_type_ == DRAMCommandType::WRITE) {
                 ++bank.consecutive_column_accesses_;
@@ -229,20 +338,29 @@ DRAMRank::execute_command(const DRAMCommand& cmd) {
             bank.open_row_ = -1;
             latency += GL_dram_conf_.tRP;
             // Update timing constraints.
-            bank.next_activate_ok_cycle_ = GL_dram_cycle_ + GL_dram_conf_.tRP;
+            bank.next_activate_ok_cycle_ = dram_cycle_ + GL_dram_conf_.tRP;
             bank.consecutive_column_accesses_ = 0;
+            --num_open_banks_;
             // Update stats.
             ++s_num_pre_;
             break;
 
         case DRAMCommandType::ACTIVATE:
+            // If the row was just closed, then keeping it open would have been a hit.
+            update_row_hit_predictor(bank, bank.last_open_row_ == static_cast<int64_t>(ROW(cmd.lineaddr_)));
             bank.open_row_ = ROW(cmd.lineaddr_);
+            bank.last_open_row_ = bank.open_row_;
+            bank.open_lineaddr_ = cmd.lineaddr_;
+            ++num_open_banks_;
             latency += GL_dram_conf_.tRCD;
             // Update timing constraints.
             bank.next_precharge_ok_cycle_ += GL_dram_conf_.tRAS;
             bank.next_column_access_ok_cycle_ += GL_dram_conf_.tRCD;
-            update_timing(next_row_activate_ok_cycle_, GL_dram_conf_.tRRD_S, GL_dram_conf_.tRRD_L);
-            last_four_act_dram_cycles_.push_back(GL_dram_cycle_);
+            update_timing(next_row_activate_ok_cycle_, dram_cycle_, GL_dram_conf_.tRRD_S, GL_dram_conf_.tRRD_L);
+            last_four_act_dram_cycles_.push_back(dram_cycle_);
+            // Update mitigations.
+            for (auto& m : mitigations_) m->on_activate(bg, ba, ROW(cmd.lineaddr_));
+            ++num_acts_since_rfm_ab_;
             // Update stats.
             ++s_num_acts_;
             break;
@@ -251,7 +369,12 @@ DRAMRank::execute_command(const DRAMCommand& cmd) {
             std::cerr << "DRAMRank::execute_command should not issue refreshes! Use DRAMRank::issue_refresh instead!\n";
             exit(1);
     }
-    any_bank_busy_until_dram_cycle_ = std::max(any_bank_busy_until_dram_cycle_, GL_dram_cycle_ + latency);
+    if (cmd.cmd_type_ != DRAMCommandType::READ && cmd.cmd_type_ != DRAMCommandType::WRITE) {
+        check_for_alert(bg, ba);
+    }
+    bank.last_access_dram_cycle_ = dram_cycle_;
+    last_cmd_dram_cycle_ = dram_cycle_;
+    any_bank_busy_until_dram_cycle_ = std::max(any_bank_busy_until_dram_cycle_, dram_cycle_ + latency);
     last_bankgroup_used_ = BANKGROUP(cmd.lineaddr_);
     return latency;
 }
@@ -263,7 +386,87 @@ void
 DRAMRank::issue_refresh() {
     for (size_t i = 0; i < NUM_BANKGROUPS; i++) {
         for (size_t j = 0; j < NUM_BANKS; j++) {
-            banks_[i][j].busy_with_ref_until_dram_cycle_ = GL_dram_cycle_ + GL_dram_conf_.tRFC;
+            banks_[i][j].busy_with_ref_until_dram_cycle_ = dram_cycle_ + GL_dram_conf_.tRFC;
+            for (auto& m : mitigations_) m->on_refresh(i, j, next_row_to_ref_);
+        }
+    }
+    next_row_to_ref_ = (next_row_to_ref_ + GL_dram_conf_.rows_refreshed) % NUM_ROWS;
+    any_bank_busy_until_dram_cycle_ = std::max(any_bank_busy_until_dram_cycle_, dram_cycle_ + GL_dram_conf_.tRFC);
+    last_cmd_dram_cycle_ = dram_cycle_;
+    ++s_num_refs_;
+    check_for_alert();
+}
+
+void
+DRAMRank::issue_rfm() {
+    uint64_t done_cycle;
+    if (needs_rfm_ab_) {
+        done_cycle = dram_cycle_ + GL_dram_conf_.tRFM;
+        for (size_t i = 0; i < NUM_BANKGROUPS; i++) {
+            for (size_t j = 0; j < NUM_BANKS; j++) {
+                banks_[i][j].busy_with_ref_until_dram_cycle_ = done_cycle;
+                for (auto& m : mitigations_) m->on_rfm(i, j, true);
+            }
+        }
+        // An RFMab covers all pending RFMsbs.
+        needs_rfm_ab_ = false;
+        std::fill(needs_rfm_sb_, needs_rfm_sb_+NUM_BANKS, false);
+        num_acts_since_rfm_ab_ = 0;
+        ++s_num_rfm_ab_;
+    } else {
+        done_cycle = dram_cycle_ + GL_dram_conf_.tRFMsb;
+        for (size_t j = 0; j < NUM_BANKS; j++) {
+            if (!needs_rfm_sb_[j]) continue;
+            for (size_t i = 0; i < NUM_BANKGROUPS; i++) {
+                banks_[i][j].busy_with_ref_until_dram_cycle_ = done_cycle;
+                for (auto& m : mitigations_) m->on_rfm(i, j, false);
+            }
+            needs_rfm_sb_[j] = false;
+            ++s_num_rfm_sb_;
+        }
+    }
+    any_bank_busy_until_dram_cycle_ = std::max(any_bank_busy_until_dram_cycle_, done_cycle);
+    last_cmd_dram_cycle_ = dram_cycle_;
+    check_for_alert();
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+bool
+DRAMRank::activate_needs_rfm(size_t bg, size_t ba) {
+    for (auto& m : mitigations_) {
+        if (m->blocks_activate(bg, ba)) {
+            if (GL_dram_conf_.rfm_mode == 1)    needs_rfm_sb_[ba] = true;
+            else                                needs_rfm_ab_ = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+DRAMRank::check_for_alert(size_t bg, size_t ba) {
+    if (GL_dram_conf_.alert_mode == 0 || alert_n_ || needs_rfm_ab_ 
+        || num_acts_since_rfm_ab_ < GL_dram_conf_.ABO_delay_acts)
+    {
+        return;
+    }
+    for (auto& m : mitigations_) {
+        if (m->wants_alert(bg, ba)) {
+            alert_n_ = true;
+            last_alert_dram_cycle_ = dram_cycle_;
+            ++s_num_alerts_;
+            return;
+        }
+    }
+}
+
+void
+DRAMRank::check_for_alert() {
+    for (size_t i = 0; i < NUM_BANKGROUPS && !alert_n_; i++) {
+        for (size_t j = 0; j < NUM_BANKS && !alert_n_; j++) {
+            check_for_alert(i, j);
         }
     }
 }
@@ -279,6 +482,14 @@ DRAMRank::all_cmd_queues_are_empty() {
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 
+void
+DRAMRank::accumulate_mitigation_stats_into(DRAMMitigationStats& st) {
+    for (auto& m : mitigations_) m->accumulate_stats_into(st);
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
 CommandQueue&
 DRAMRank::get_command_queue(size_t bg, size_t ba) {
     return cmd_queues_[ bg*NUM_BANKS + ba ];
@@ -9,6 +9,7 @@
 #include "defs.h"
 #include "dram/address.h"
 #include "dram/bank.h"
+#include "dram/mitigation.h"
 
 #include <deque>
 #include <unordered_set>
@@ -22,14 +23,16 @@ struct DRAMCommand {
     DRAMCommandType cmd_type_;
 };
 
-inline constexpr DRAMCommandType READ_CMD() {
-    if constexpr (DRAM_PAGE_POLICY == DRAMPagePolicy::OPEN) return DRAMCommandType::READ;
-    else                                                    return DRAMCommandType::READ_PRECHARGE;
+inline bool is_read_command(DRAMCommandType t) {
+    return t == DRAMCommandType::READ || t == DRAMCommandType::READ_PRECHARGE;
 }
 
-inline constexpr DRAMCommandType WRITE_CMD() {
-    if constexpr (DRAM_PAGE_POLICY == DRAMPagePolicy::OPEN) return DRAMCommandType::WRITE;
-    else                                                    return DRAMCommandType::WRITE_PRECHARGE;
+inline bool is_write_command(DRAMCommandType t) {
+    return t == DRAMCommandType::WRITE || t == DRAMCommandType::WRITE_PRECHARGE;
+}
+
+inline bool is_column_command(DRAMCommandType t) {
+    return is_read_command(t) || is_write_command(t);
 }
 
 using CommandQueue = std::vector<DRAMCommand>;
@@ -51,6 +54,20 @@ public:
     uint64_t s_num_pre_ =0;
     uint64_t s_num_pre_demand_ =0;
     uint64_t s_row_buf_hits_ =0;
+    uint64_t s_num_pre_timeout_ =0;
+    uint64_t s_num_alerts_ =0;
+    uint64_t s_num_rfm_ab_ =0;
+    uint64_t s_num_rfm_sb_ =0;
+    uint64_t s_num_refs_ =0;
+    /*
+     * Cycles spent in each background power state (active/precharged standby
+     * and active/precharged power-down).
+     * */
+    uint64_t s_act_stb_cycles_ =0;
+    uint64_t s_pre_stb_cycles_ =0;
+    uint64_t s_act_pd_cycles_ =0;
+    uint64_t s_pre_pd_cycles_ =0;
+    uint64_t s_num_powerdowns_ =0;
 private:
     std::unordered_set<uint64_t> lineaddr_with_recent_row_miss_;
 
@@ -78,16 +95,50 @@ private:
      * This is to check if any bank is performing an operation.
      * */
     uint64_t any_bank_busy_until_dram_cycle_ =0;
+    /*
+     * Power state: `num_open_banks_` is the number of banks with an open row
+     * (the rank is in active standby/power-down if this is nonzero).
+     * `powerdown_exit_done_dram_cycle_` enforces tXP after power-down exit.
+     * */
+    size_t num_open_banks_ =0;
+    bool is_powered_down_ =false;
+    uint64_t powerdown_entry_dram_cycle_ =0;
+    uint64_t powerdown_exit_done_dram_cycle_ =0;
+    uint64_t last_cmd_dram_cycle_ =0;
+    /*
+     * The DRAM cycle being simulated, passed in by `tick` (subchannels may be
+     * ticked ahead of `GL_dram_cycle_`; see `DRAMController`).
+     * */
+    uint64_t dram_cycle_ =0;
+    /*
+     * Row-hammer mitigation (see `mitigation.h`):
+     *  `next_row_to_ref_` is the first row refreshed by the next REF.
+     *  `alert_n_` is set when a bank asks for an alert (ABO). After
+     *      `tABO_act` cycles, the rank requests an RFMab.
+     *  `num_acts_since_rfm_ab_` enforces `ABO_delay_acts`.
+     *  `needs_rfm_ab_` and `needs_rfm_sb_` are pending RFMs. A pending
+     *      RFMab blocks the whole rank; a pending RFMsb blocks all banks with
+     *      the given bank index.
+     * */
+    std::vector<std::unique_ptr<DRAMMitigation>> mitigations_;
+    uint64_t next_row_to_ref_ =0;
+
+    bool alert_n_ =false;
+    uint64_t last_alert_dram_cycle_ =0;
+    uint64_t num_acts_since_rfm_ab_ =0;
+
+    bool needs_rfm_ab_ =false;
+    bool needs_rfm_sb_[NUM_BANKS] = {};
 public:
     DRAMRank(void);
     
-    void tick(void);
+    void tick(uint64_t dram_cycle);
 
     void set_needs_refresh(void);
     /*
-     * Trys to insert a command (read/write) for `lineaddr`. Depending on the
-     * page policy, this is either `READ` or `READ_PRECHARGE` (or the corresponding
-     * WRITE versions if `IS_READ == false`).
+     * Trys to insert a command (`READ` or `WRITE`) for `lineaddr`. Depending on
+     * the page policy, the command may be issued as a `READ_PRECHARGE` or
+     * `WRITE_PRECHARGE` (see `should_close_row_after`).
      *
      * Returns true if the command was inserted.
      * */
@@ -114,8 +165,40 @@ public:
      * */
     CommandQueue& get_command_queue(size_t bg, size_t ba);
     bool all_cmd_queues_are_empty(void);
+
+    void accumulate_mitigation_stats_into(DRAMMitigationStats&);
 private:
     void issue_refresh(void);
+    void issue_rfm(void);
+    /*
+     * Enters or exits power-down (if enabled in `GL_dram_conf_`).
+     * */
+    void update_powerdown_state(void);
+    bool is_awake(void);
+    bool has_pending_rfm(void);
+    /*
+     * Returns true if the column access at `it` should auto-precharge, given
+     * the page policy (`GL_dram_conf_.page_policy`) and the commands queued
+     * after it.
+     * */
+    bool should_close_row_after(const DRAMBank&, CommandQueue::iterator it, CommandQueue::iterator end);
+    /*
+     * For `DRAMPagePolicy::TIMEOUT`: finds a bank whose open row has not been
+     * accessed for `page_timeout` cycles (and has no queued accesses), and
+     * sets `DRAMCommand&` to a precharge for that bank.
+     * */
+    bool select_timeout_precharge(DRAMCommand&);
+    /*
+     * Returns true if an ACT to the bank must wait for an RFM. If so, the RFM
+     * is requested.
+     * */
+    bool activate_needs_rfm(size_t bg, size_t ba);
+    /*
+     * Asserts ALERT_n if any mitigation asks for it. `check_for_alert(void)`
+     * checks all banks in the rank.
+     * */
+    void check_for_alert(size_t bg, size_t ba);
+    void check_for_alert(void);
 };
 
 ////////////////////////////////////////////////////////////////
@@ -123,9 +206,23 @@ private:
 
 inline void DRAMRank::set_needs_refresh() { is_waiting_to_do_ref_ = true; }
 
+inline bool
+DRAMRank::is_awake() {
+    return !is_powered_down_ && dram_cycle_ >= powerdown_exit_done_dram_cycle_;
+}
+
+inline bool
+DRAMRank::has_pending_rfm() {
+    if (needs_rfm_ab_) return true;
+    for (size_t i = 0; i < NUM_BANKS; i++) {
+        if (needs_rfm_sb_[i]) return true;
+    }
+    return false;
+}
+
 template <bool IS_READ> bool
 DRAMRank::try_and_insert_command(uint64_t lineaddr) {
-    constexpr DRAMCommandType CMD_TYPE = IS_READ ? READ_CMD() : WRITE_CMD();
+    constexpr DRAMCommandType CMD_TYPE = IS_READ ? DRAMCommandType::READ : DRAMCommandType::WRITE;
 
     size_t bg = BANKGROUP(lineaddr),
            ba = BANK(lineaddr);
@@ -6,7 +6,9 @@
 #include "dram/subchannel.h"
 #include "dram/config.h"
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
@@ -16,12 +18,28 @@ DRAMSubchannelStats::print_stats(std::ostream& out) {
     PRINT_STAT(out, "DRAM_OPP_WRITE_DRAINS", s_num_opp_write_drains_);
     PRINT_STAT(out, "DRAM_ALL_WRITE_DRAINS", s_num_write_drains_);
     PRINT_STAT(out, "DRAM_TREFI", s_num_trefi_);
+    PRINT_STAT(out, "DRAM_RD_TO_WR_TURNAROUNDS", s_num_rd_to_wr_turnarounds_);
+    PRINT_STAT(out, "DRAM_WR_TO_RD_TURNAROUNDS", s_num_wr_to_rd_turnarounds_);
+    PRINT_STAT(out, "DRAM_BUS_IDLE_CYCLES", s_bus_idle_cycles_);
+    PRINT_STAT(out, "DRAM_BUS_IDLE_CYCLES_PENDING", s_bus_idle_cycles_with_pending_);
     PRINT_STAT(out, "DRAM_READ_CMDS", s_num_read_cmds_);
     PRINT_STAT(out, "DRAM_WRITE_CMDS", s_num_write_cmds_);
     PRINT_STAT(out, "DRAM_ROW_BUFFER_HITS", s_row_buf_hits_);
     PRINT_STAT(out, "DRAM_ACTIVATIONS", s_num_acts_);
     PRINT_STAT(out, "DRAM_PRECHARGES", s_num_pre_);
     PRINT_STAT(out, "DRAM_PRE_DEMAND", s_num_pre_demand_);
+    if (GL_dram_conf_.powerdown_enabled) {
+        PRINT_STAT(out, "DRAM_POWERDOWNS", s_num_powerdowns_);
+    }
+    if (GL_dram_conf_.page_policy == DRAMPagePolicy::TIMEOUT) {
+        PRINT_STAT(out, "DRAM_PRE_TIMEOUT", s_num_pre_timeout_);
+    }
+    if (mitigation_is_enabled(GL_dram_conf_)) {
+        PRINT_STAT(out, "DRAM_ALERTS", s_num_alerts_);
+        PRINT_STAT(out, "DRAM_RFMAB", s_num_rfm_ab_);
+        PRINT_STAT(out, "DRAM_RFMSB", s_num_rfm_sb_);
+        mitigation_stats_.print_stats(out);
+    }
 }
 
 ////////////////////////////////////////////////////////////////
@@ -30,36 +48,50 @@ DRAMSubchannelStats::print_stats(std::ostream& out) {
 DRAMSubchannel::DRAMSubchannel()
 {
     read_queue_.reserve(TRANS_QUEUE_SIZE);
-    write_buffer_.reserve(TRANS_QUEUE_SIZE);
+    for (size_t i = 0; i < N_WRITE_BUFFERS; i++) {
+        write_batch_row_[i] = -1;
+    }
 }
 
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 
 void
-DRAMSubchannel::tick() {
+DRAMSubchannel::tick(uint64_t dram_cycle) {
+    dram_cycle_ = dram_cycle;
+    accept_requests();
     // Check if we need to perform a refresh.
-    if (GL_dram_cycle_ >= next_trefi_dram_cycle_) {
+    if (dram_cycle_ >= next_trefi_dram_cycle_) {
         schedule_refresh();
     }
     for (size_t i = 0; i < NUM_RANKS; i++) {
-        ranks_[i].tick();
+        ranks_[i].tick(dram_cycle_);
     }
     // Try to issue a command.
     DRAMCommand cmd;
     for (size_t ii = 0; ii < NUM_RANKS; ii++) {
         DRAMRank& rk = ranks_[next_rank_with_cmd_];
-        next_rank_with_cmd_ = INCREMENT_AND_MOD_BY_POW2(next_rank_with_cmd_, NUM_RANKS);
+        if (++next_rank_with_cmd_ == NUM_RANKS) {
+            next_rank_with_cmd_ = 0;
+        }
 
         if (rk.select_command(cmd)) {
             uint64_t latency = rk.execute_command(cmd);
+            update_data_bus(cmd);
             // Update pending results.
-            if (cmd.cmd_type_ == READ_CMD()) complete_read(cmd.lineaddr_, latency);
-            else                             complete_write(cmd.lineaddr_, latency);
+            if (is_read_command(cmd.cmd_type_))         complete_read(cmd.lineaddr_, latency);
+            else if (is_write_command(cmd.cmd_type_))   complete_write(cmd.lineaddr_, latency);
 
             break;
         }
     }
+    // Update bus stats.
+    if (dram_cycle_ >= data_bus_busy_until_dram_cycle_) {
+        ++s_bus_idle_cycles_;
+        if (!read_queue_.empty() || !pending_reads_.empty() || num_writes_ > 0 || !all_cmd_queues_are_empty()) {
+            ++s_bus_idle_cycles_with_pending_;
+        }
+    }
 
     schedule_next_request();
 }
@@ -69,25 +101,40 @@ DRAMSubchannel::tick() {
 
 bool
 DRAMSubchannel::make_request(uint64_t lineaddr, bool is_read) {
-    if (is_read && read_queue_.size() < TRANS_QUEUE_SIZE) {
+    if (is_read && read_queue_.size() + read_inbox_.size() < TRANS_QUEUE_SIZE) {
         DRAMTransaction* trans = new DRAMTransaction(lineaddr);
         if (pending_writes_.count(lineaddr)) {
             trans->cpu_cycle_fired_ = GL_cycle_;
             trans->dram_cycle_finished_ = GL_dram_cycle_;
             finished_reads_.push(trans);
         } else {
-            read_queue_.push_back(trans);
-            pending_reads_.insert({lineaddr, trans});
+            read_inbox_.push_back({GL_dram_cycle_, trans});
         }
         return true;
-    } else if (!is_read && write_buffer_.size() < TRANS_QUEUE_SIZE) {
-        write_buffer_.push_back(lineaddr);
+    } else if (!is_read && num_writes_ + write_inbox_.size() < TRANS_QUEUE_SIZE) {
+        write_inbox_.push_back((DRAMWrite) {lineaddr, GL_dram_cycle_});
         pending_writes_.insert(lineaddr);
         return true;
     }
     return false;
 }
 
+void
+DRAMSubchannel::accept_requests() {
+    while (!read_inbox_.empty() && read_inbox_.front().first <= dram_cycle_) {
+        DRAMTransaction* trans = read_inbox_.front().second;
+        read_queue_.push_back(trans);
+        pending_reads_.insert({trans->lineaddr_, trans});
+        read_inbox_.pop_front();
+    }
+    while (!write_inbox_.empty() && write_inbox_.front().dram_cycle_added_ <= dram_cycle_) {
+        const DRAMWrite& w = write_inbox_.front();
+        write_buffer_[ write_buffer_index(w.lineaddr_) ].push_back(w);
+        ++num_writes_;
+        write_inbox_.pop_front();
+    }
+}
+
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 
@@ -101,6 +148,10 @@ DRAMSubchannel::accumulate_stats_into(DRAMSubchannelStats& st) {
     ADD_SC_STAT(s_tot_cycles_between_write_drains_);
     ADD_SC_STAT(s_tot_cycles_between_opp_write_drains_);
     ADD_SC_STAT(s_num_trefi_);
+    ADD_SC_STAT(s_num_rd_to_wr_turnarounds_);
+    ADD_SC_STAT(s_num_wr_to_rd_turnarounds_);
+    ADD_SC_STAT(s_bus_idle_cycles_);
+    ADD_SC_STAT(s_bus_idle_cycles_with_pending_);
 
     for (size_t i = 0; i < NUM_RANKS; i++) {
         ADD_RK_STAT(s_num_read_cmds_, i);
@@ -109,6 +160,17 @@ DRAMSubchannel::accumulate_stats_into(DRAMSubchannelStats& st) {
         ADD_RK_STAT(s_num_pre_, i);
         ADD_RK_STAT(s_row_buf_hits_, i);
         ADD_RK_STAT(s_num_pre_demand_, i);
+        ADD_RK_STAT(s_num_pre_timeout_, i);
+        ADD_RK_STAT(s_num_alerts_, i);
+        ADD_RK_STAT(s_num_rfm_ab_, i);
+        ADD_RK_STAT(s_num_rfm_sb_, i);
+        ranks_[i].accumulate_mitigation_stats_into(st.mitigation_stats_);
+        ADD_RK_STAT(s_num_refs_, i);
+        ADD_RK_STAT(s_act_stb_cycles_, i);
+        ADD_RK_STAT(s_pre_stb_cycles_, i);
+        ADD_RK_STAT(s_act_pd_cycles_, i);
+        ADD_RK_STAT(s_pre_pd_cycles_, i);
+        ADD_RK_STAT(s_num_powerdowns_, i);
     }
 }
 
@@ -136,40 +198,144 @@ DRAMSubchannel::schedule_refresh() {
 
 void
 DRAMSubchannel::schedule_next_request() {
-    bool write_buf_is_full = write_buffer_.size() == TRANS_QUEUE_SIZE,
-         cmd_queue_is_empty = all_cmd_queues_are_empty() && write_buffer_.size() > 8;
-    // Check if we need to turnaround the bus.
-    if (num_writes_to_drain_ == 0 && (write_buf_is_full || cmd_queue_is_empty)) {
-        num_writes_to_drain_ = write_buffer_.size();
+    update_write_drain_mode();
+    // Now, perform accesses.
+    if (is_draining_writes_ && drain_write()) {
+        return;
+    }
+    // A buffered write waits for any older read to its line (see
+    // `try_and_insert_command`). If the drain is stuck, let those reads go,
+    // or the drain never ends.
+    for (auto it = read_queue_.begin(); it != read_queue_.end(); it++) {
+        DRAMTransaction* trans = *it;
+        if (is_draining_writes_ && pending_writes_.count(trans->lineaddr_) == 0) {
+            continue;
+        }
+        if (try_and_insert_command<true>(trans->lineaddr_)) {
+            trans->cpu_cycle_fired_ = GL_cycle_;
+            read_queue_.erase(it);
+            break;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+DRAMSubchannel::update_write_drain_mode() {
+    const DRAMConfig& conf = GL_dram_conf_;
+    const bool read_priority = conf.wr_drain_mode == DRAMWriteDrainMode::READ_PRIORITY;
+
+    if (is_draining_writes_) {
+        bool done = num_writes_ <= conf.wr_low_watermark
+                    || (read_priority && !write_drain_is_forced_ && !read_queue_.empty());
+        if (done) {
+            is_draining_writes_ = false;
+        }
+        return;
+    }
+
+    if (num_writes_ == 0) return;
+
+    bool at_high_watermark = num_writes_ >= std::min(conf.wr_high_watermark, TRANS_QUEUE_SIZE),
+         is_opp_drain = all_cmd_queues_are_empty() && num_writes_ > conf.wr_opp_drain_threshold,
+         is_starved = false,
+         reads_are_idle = false;
+    if (read_priority) {
+        is_starved = dram_cycle_ >= oldest_write_dram_cycle() + conf.wr_starvation_cycles;
+        reads_are_idle = read_queue_.empty();
+    }
+
+    if (at_high_watermark || is_opp_drain || is_starved || reads_are_idle) {
+        is_draining_writes_ = true;
+        write_drain_is_forced_ = at_high_watermark || is_starved;
         // Update stats.
         ++s_num_write_drains_;
-        s_tot_cycles_between_write_drains_ += GL_cycle_ - last_drain_cycle_;
-        last_drain_cycle_ = GL_cycle_;
-        if (cmd_queue_is_empty) {
+        s_tot_cycles_between_write_drains_ += dram_cycle_ - last_drain_dram_cycle_;
+        last_drain_dram_cycle_ = dram_cycle_;
+        if (is_opp_drain) {
             ++s_num_opp_write_drains_;
-            s_tot_cycles_between_opp_write_drains_ += GL_cycle_ - last_opp_drain_cycle_;
-            last_opp_drain_cycle_ = GL_cycle_;
+            s_tot_cycles_between_opp_write_drains_ += dram_cycle_ - last_opp_drain_dram_cycle_;
+            last_opp_drain_dram_cycle_ = dram_cycle_;
         }
     }
-    // Now, perform accesses.
-    if (num_writes_to_drain_ > 0) {
-        for (auto it = write_buffer_.begin(); it != write_buffer_.end(); it++) {
-            if (try_and_insert_command<false>(*it)) {
-                --num_writes_to_drain_;
-                write_buffer_.erase(it);
-                break;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+bool
+DRAMSubchannel::drain_write() {
+    for (size_t ii = 0; ii < N_WRITE_BUFFERS; ii++) {
+        size_t idx = next_write_buffer_idx_;
+        WriteBuffer& wb = write_buffer_[idx];
+        if (wb.empty()) {
+            if (++next_write_buffer_idx_ == N_WRITE_BUFFERS) {
+                next_write_buffer_idx_ = 0;
             }
+            continue;
         }
-    } else {
-        for (auto it = read_queue_.begin(); it != read_queue_.end(); it++) {
-            DRAMTransaction* trans = *it;
-            if (try_and_insert_command<true>(trans->lineaddr_)) {
-                trans->cpu_cycle_fired_ = GL_cycle_;
-                read_queue_.erase(it);
-                break;
+        // Pick a write: first one to the row being batched, then one to the open row,
+        // and then the oldest write.
+        const DRAMBank& bank = ranks_[ RANK(wb[0].lineaddr_) ].banks_[ BANKGROUP(wb[0].lineaddr_) ][ BANK(wb[0].lineaddr_) ];
+        auto to_row = [&wb] (int64_t r) {
+            return std::find_if(wb.begin(), wb.end(), 
+                    [r] (const DRAMWrite& w) { return static_cast<int64_t>(ROW(w.lineaddr_)) == r; });
+        };
+        auto it = to_row(write_batch_row_[idx]);
+        if (it == wb.end()) it = to_row(bank.open_row_);
+        if (it == wb.end()) it = wb.begin();
+
+        if (try_and_insert_command<false>(it->lineaddr_)) {
+            int64_t r = ROW(it->lineaddr_);
+            wb.erase(it);
+            --num_writes_;
+            // Stay on this bank if there are more writes to the same row.
+            write_batch_row_[idx] = r;
+            if (to_row(r) == wb.end()) {
+                write_batch_row_[idx] = -1;
+                if (++next_write_buffer_idx_ == N_WRITE_BUFFERS) {
+                    next_write_buffer_idx_ = 0;
+                }
             }
+            return true;
+        }
+        if (++next_write_buffer_idx_ == N_WRITE_BUFFERS) {
+            next_write_buffer_idx_ = 0;
         }
     }
+    return false;
+}
+
+uint64_t
+DRAMSubchannel::oldest_write_dram_cycle() {
+    uint64_t oldest = std::numeric_limits<uint64_t>::max();
+    for (size_t i = 0; i < N_WRITE_BUFFERS; i++) {
+        if (!write_buffer_[i].empty()) {
+            oldest = std::min(oldest, write_buffer_[i][0].dram_cycle_added_);
+        }
+    }
+    return oldest;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+DRAMSubchannel::update_data_bus(const DRAMCommand& cmd) {
+    bool is_read = is_read_command(cmd.cmd_type_),
+         is_write = is_write_command(cmd.cmd_type_);
+    if (!is_read && !is_write) return;
+
+    if (any_column_cmd_) {
+        if (is_write && !last_column_cmd_was_write_) ++s_num_rd_to_wr_turnarounds_;
+        if (is_read && last_column_cmd_was_write_)   ++s_num_wr_to_rd_turnarounds_;
+    }
+    any_column_cmd_ = true;
+    last_column_cmd_was_write_ = is_write;
+
+    data_bus_busy_until_dram_cycle_ = dram_cycle_ + BURST_LENGTH/2;
 }
 
 ////////////////////////////////////////////////////////////////
@@ -180,7 +346,7 @@ DRAMSubchannel::complete_read(uint64_t lineaddr, uint64_t latency) {
     while (pending_reads_.count(lineaddr)) {
         auto it = pending_reads_.find(lineaddr);
         DRAMTransaction* trans = it->second;
-        trans->dram_cycle_finished_ = GL_dram_cycle_ + latency;
+        trans->dram_cycle_finished_ = dram_cycle_ + latency;
 
         finished_reads_.push(trans);
         pending_reads_.erase(it);
@@ -9,6 +9,7 @@
 #include "defs.h"
 #include "dram/rank.h"
 
+#include <deque>
 #include <queue>
 #include <unordered_map>
 #include <unordered_set>
@@ -37,6 +38,16 @@ struct DRAMTransactionComparator {
     }
 };
 
+/*
+ * Buffered write (see `DRAMSubchannel::write_buffer_`).
+ * */
+struct DRAMWrite {
+    uint64_t lineaddr_;
+    uint64_t dram_cycle_added_;
+};
+
+using WriteBuffer = std::vector<DRAMWrite>;
+
 using TransactionReturnQueue = std::priority_queue<DRAMTransaction*, 
                                                     std::vector<DRAMTransaction*>,
                                                     DRAMTransactionComparator>;
@@ -50,6 +61,10 @@ struct DRAMSubchannelStats {
     uint64_t s_tot_cycles_between_write_drains_ =0;
     uint64_t s_tot_cycles_between_opp_write_drains_ =0;
     uint64_t s_num_trefi_ =0;
+    uint64_t s_num_rd_to_wr_turnarounds_ =0;
+    uint64_t s_num_wr_to_rd_turnarounds_ =0;
+    uint64_t s_bus_idle_cycles_ =0;
+    uint64_t s_bus_idle_cycles_with_pending_ =0;
 
     uint64_t s_num_read_cmds_ =0;
     uint64_t s_num_write_cmds_ =0;
@@ -57,6 +72,19 @@ struct DRAMSubchannelStats {
     uint64_t s_num_acts_ =0;
     uint64_t s_num_pre_ =0;
     uint64_t s_num_pre_demand_ =0;
+    uint64_t s_num_pre_timeout_ =0;
+
+    uint64_t s_num_alerts_ =0;
+    uint64_t s_num_rfm_ab_ =0;
+    uint64_t s_num_rfm_sb_ =0;
+    DRAMMitigationStats mitigation_stats_;
+
+    uint64_t s_num_refs_ =0;
+    uint64_t s_act_stb_cycles_ =0;
+    uint64_t s_pre_stb_cycles_ =0;
+    uint64_t s_act_pd_cycles_ =0;
+    uint64_t s_pre_pd_cycles_ =0;
+    uint64_t s_num_powerdowns_ =0;
 
     void print_stats(std::ostream&);
 };
@@ -67,17 +95,27 @@ struct DRAMSubchannelStats {
 class DRAMSubchannel {
 public:
     constexpr static size_t TRANS_QUEUE_SIZE = 128;
+    constexpr static size_t N_WRITE_BUFFERS = NUM_RANKS*NUM_BANKGROUPS*NUM_BANKS;
     /*
      * An "opp_write_drain" is an opportunistic write drain
      * that occurs when there are no pending commands to all
      *
-     * DRAM banks.
+     * DRAM banks. Times between drains are in DRAM cycles.
+     *
+     * Turnarounds are counted on the data bus (a WRITE issued after a READ
+     * or vice versa). The bus is idle in any DRAM cycle without a data
+     * transfer: `s_bus_idle_cycles_with_pending_` only counts idle cycles
+     * where the subchannel had outstanding requests.
      * */
     uint64_t s_num_opp_write_drains_ =0;
     uint64_t s_num_write_drains_ =0;
     uint64_t s_tot_cycles_between_write_drains_ =0;
     uint64_t s_tot_cycles_between_opp_write_drains_ =0;
     uint64_t s_num_trefi_ =0;
+    uint64_t s_num_rd_to_wr_turnarounds_ =0;
+    uint64_t s_num_wr_to_rd_turnarounds_ =0;
+    uint64_t s_bus_idle_cycles_ =0;
+    uint64_t s_bus_idle_cycles_with_pending_ =0;
 
     size_t scid_;
 
@@ -96,28 +134,57 @@ private:
     std::unordered_multimap<uint64_t, DRAMTransaction*> pending_reads_;
     /*
      * Write management: unlike reads, the metadata of `DRAMTransaction` is
-     * unnecessary -- we only care about where we are writing.
+     * unnecessary -- we only care about where (and when) we are writing.
+     *
+     * Writes are buffered per bank (`write_buffer_` is indexed by 
+     * `write_buffer_index`), in arrival order. `num_writes_` is the total
+     * number of buffered writes.
      * 
-     * If `num_writes_to_drain_ > 0`, then the channel switches to
-     * write mode and drains `write_buffer_`.
+     * If `is_draining_writes_`, then the channel is in write mode and drains
+     * the buffers one bank at a time: `next_write_buffer_idx_` stays on a bank
+     * while it has writes to `write_batch_row_` (the last row drained for that
+     * bank), so writes to the same row are issued back-to-back.
      * */
-    std::vector<uint64_t> write_buffer_;
+    WriteBuffer write_buffer_[N_WRITE_BUFFERS];
+    int64_t write_batch_row_[N_WRITE_BUFFERS];
     std::unordered_set<uint64_t> pending_writes_;
-    size_t num_writes_to_drain_ =0;
+    size_t num_writes_ =0;
+    size_t next_write_buffer_idx_ =0;
+
+    bool is_draining_writes_ =false;
+    bool write_drain_is_forced_ =false;
 
-    uint64_t last_drain_cycle_ =0;
-    uint64_t last_opp_drain_cycle_ = 0;
+    uint64_t last_drain_dram_cycle_ =0;
+    uint64_t last_opp_drain_dram_cycle_ =0;
+    /*
+     * Data bus tracking (for turnaround and idle stats). There is no
+     * turnaround before the first column command (`any_column_cmd_`).
+     * */
+    uint64_t data_bus_busy_until_dram_cycle_ =0;
+    bool any_column_cmd_ =false;
+    bool last_column_cmd_was_write_ =false;
     /*
      * Refresh management.
      * */
     uint64_t next_trefi_dram_cycle_ =0;
     size_t next_rank_to_ref_ =0;
+    /*
+     * `make_request` is called between ticks, and the subchannel may be ticked
+     * several DRAM cycles at a time (see `DRAMController`). So requests wait
+     * in `read_inbox_` and `write_inbox_`, with the `GL_dram_cycle_` they were
+     * made in, and enter the queues when `tick` reaches that cycle.
+     * `dram_cycle_` is the cycle being ticked.
+     * */
+    std::deque<std::pair<uint64_t, DRAMTransaction*>> read_inbox_;
+    std::deque<DRAMWrite> write_inbox_;
+    uint64_t dram_cycle_ =0;
 public:
     DRAMSubchannel(void);
 
-    void tick(void);
+    void tick(uint64_t dram_cycle);
     /*
-     * Returns true if the request was enqueued.
+     * Returns true if the request was enqueued. Buffered writes (including
+     * those still in `write_inbox_`) forward to reads immediately.
      * */
     bool make_request(uint64_t lineaddr, bool is_read);
     /*
@@ -126,8 +193,21 @@ public:
      * */ 
     void accumulate_stats_into(DRAMSubchannelStats&);
 private:
+    void accept_requests(void);
     void schedule_refresh(void);
     void schedule_next_request(void);
+    /*
+     * Decides whether the subchannel should switch between read and write
+     * mode (see `DRAMConfig::wr_drain_mode`).
+     * */
+    void update_write_drain_mode(void);
+    /*
+     * Inserts one buffered write into the command queues. Returns true on
+     * success.
+     * */
+    bool drain_write(void);
+    uint64_t oldest_write_dram_cycle(void);
+    void update_data_bus(const DRAMCommand&);
 
     void complete_read(uint64_t, uint64_t latency);
     void complete_write(uint64_t, uint64_t latency);
@@ -141,6 +221,11 @@ private:
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 
+inline size_t
+write_buffer_index(uint64_t lineaddr) {
+    return (RANK(lineaddr)*NUM_BANKGROUPS + BANKGROUP(lineaddr))*NUM_BANKS + BANK(lineaddr);
+}
+
 template <bool IS_READ> inline bool
 DRAMSubchannel::try_and_insert_command(uint64_t lineaddr) {
     if constexpr (!IS_READ) {
@@ -5,6 +5,7 @@
 
 #include "ds3/interface.h"
 #include "cache/controller/llc2.h"
+#include "os.h"
 #include "utils/bitcount.h"
 
 ////////////////////////////////////////////////////////////////
@@ -15,7 +16,9 @@ DS3Interface::DS3Interface(std::string ds3conf) {
             [this] (uint64_t byteaddr)
             {
                 uint64_t lineaddr = byteaddr >> Log2<LINESIZE>::value;
-                GL_llc_controller_->mark_as_finished(lineaddr);
+                if (GL_os_->tiers_ == nullptr || !GL_os_->tiers_->finish_copy_read(lineaddr)) {
+                    GL_llc_controller_->mark_as_finished(lineaddr);
+                }
             },
             [this] (uint64_t byteaddr)
             {}
@@ -0,0 +1,279 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#include "mmu.h"
+#include "cache/controller/llc2.h"
+
+#include <algorithm>
+
+#include <stdlib.h>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+TLB::TLB(size_t entries, size_t ways)
+    :sets_(entries/ways),
+    ways_(ways),
+    keys_(entries, ~0ULL),
+    lru_timestamps_(entries, 0)
+{
+    if (entries == 0 || entries % ways != 0) {
+        std::cerr << "TLB: " << entries << " entries is not a non-zero multiple of "
+            << ways << " ways.\n";
+        exit(1);
+    }
+}
+
+bool
+TLB::probe(uint64_t key) {
+    size_t base = (key % sets_)*ways_;
+    for (size_t i = base; i < base+ways_; i++) {
+        if (keys_[i] == key) {
+            lru_timestamps_[i] = ++access_ctr_;
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+TLB::fill(uint64_t key) {
+    if (probe(key)) {
+        return;
+    }
+    size_t base = (key % sets_)*ways_;
+    auto vic_it = std::min_element(lru_timestamps_.begin()+base, lru_timestamps_.begin()+base+ways_);
+    size_t vic = vic_it - lru_timestamps_.begin();
+    keys_[vic] = key;
+    lru_timestamps_[vic] = ++access_ctr_;
+}
+
+bool
+TLB::invalidate(uint64_t key) {
+    size_t base = (key % sets_)*ways_;
+    for (size_t i = base; i < base+ways_; i++) {
+        if (keys_[i] == key) {
+            keys_[i] = ~0ULL;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+TLB::invalidate_range(uint64_t first, uint64_t count) {
+    bool any = false;
+    for (uint64_t& k : keys_) {
+        if (k - first < count) {
+            k = ~0ULL;
+            any = true;
+        }
+    }
+    return any;
+}
+
+void
+TLB::flush() {
+    std::fill(keys_.begin(), keys_.end(), ~0ULL);
+}
+
+size_t
+TLB::valid_entries() const {
+    return keys_.size() - std::count(keys_.begin(), keys_.end(), ~0ULL);
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+MMU::MMU(size_t coreid, const MMUConfig& conf)
+    :coreid_(coreid),
+    conf_(conf),
+    dtlb_(conf.dtlb_entries_, DTLB_ASSOC),
+    stlb_(conf.stlb_entries_, STLB_ASSOC)
+{
+    for (size_t lvl = 1; lvl < PT_LEVELS; lvl++) {
+        pwc_.emplace_back(conf.pwc_entries_, PWC_ASSOC);
+    }
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+MMU::tick() {
+    if (!walk_active_ || walk_load_in_flight_ || GL_cycle_ < walk_step_ready_) {
+        return;
+    }
+    if (walk_loads_left_ == 0) {
+        finish_walk();
+        return;
+    }
+    size_t lvl = walk_leaf_level_ + walk_loads_left_ - 1;
+    // On an LLC hit, `walk_step_done` is called before `access` returns.
+    walk_load_in_flight_ = true;
+    if (GL_llc_controller_->access(walk_pte_lineaddr_[lvl], coreid_, MMU_ROBID, 0, true) == -1) {
+        walk_load_in_flight_ = false;
+        return;
+    }
+    ++s_walk_loads_;
+    --walk_loads_left_;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+bool
+MMU::translate(uint64_t vpn, uint64_t& begin, uint64_t& latency) {
+    begin = GL_cycle_;
+    latency = 0;
+    if (conf_.perfect_) {
+        return true;
+    }
+    if (walk_active_) {
+        return false;
+    }
+    // The instruction that waited on the last walk.
+    if (walk_done_ && walk_vpn_ == vpn) {
+        begin = walk_begin_;
+        return true;
+    }
+    walk_done_ = false;
+
+    ++s_accesses_;
+    if (lookup(dtlb_, vpn)) {
+        return true;
+    }
+    ++s_dtlb_misses_;
+    size_t level;
+    if (lookup(stlb_, vpn, &level)) {
+        dtlb_.fill(tlb_key(vpn, level));
+        latency = STLB_LATENCY;
+        return true;
+    }
+    ++s_stlb_misses_;
+    start_walk(vpn);
+    return false;
+}
+
+void
+MMU::walk_step_done(uint64_t when) {
+    walk_load_in_flight_ = false;
+    walk_step_ready_ = std::max(when, GL_cycle_);
+}
+
+void
+MMU::flush() {
+    dtlb_.flush();
+    stlb_.flush();
+    for (TLB& t : pwc_) {
+        t.flush();
+    }
+}
+
+bool
+MMU::invalidate(uint64_t vpn) {
+    if (conf_.perfect_) {
+        return false;
+    }
+    // The last walk's translation is not reused either.
+    if (walk_done_ && walk_vpn_ == vpn) {
+        walk_done_ = false;
+    }
+    bool in_dtlb = dtlb_.invalidate(tlb_key(vpn, 0)),
+         in_stlb = stlb_.invalidate(tlb_key(vpn, 0));
+    return in_dtlb || in_stlb;
+}
+
+bool
+MMU::invalidate_region(uint64_t first_vpn, size_t level) {
+    if (conf_.perfect_) {
+        return false;
+    }
+    const uint64_t num_pages = 1ULL << (level*PT_BITS_PER_LEVEL);
+    if (walk_done_ && walk_vpn_ - first_vpn < num_pages) {
+        walk_done_ = false;
+    }
+    bool in_dtlb = dtlb_.invalidate_range(tlb_key(first_vpn, 0), num_pages),
+         in_stlb = stlb_.invalidate_range(tlb_key(first_vpn, 0), num_pages);
+    // The region's entry at `level` and the nodes below it are gone.
+    for (size_t lvl = 1; lvl <= level; lvl++) {
+        pwc_[lvl-1].invalidate_range(tlb_key(first_vpn, lvl), num_pages >> (lvl*PT_BITS_PER_LEVEL));
+    }
+    return in_dtlb || in_stlb;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+MMU::print_stats(std::ostream& out, std::string header) {
+    if (conf_.perfect_) {
+        return;
+    }
+    double avg_walk_latency = s_walks_ ? ((double)s_tot_walk_latency_)/((double)s_walks_) : 0.0;
+
+    PRINT_STAT(out, header + "_TLB_ACCESSES", s_accesses_);
+    PRINT_STAT(out, header + "_DTLB_MISSES", s_dtlb_misses_);
+    PRINT_STAT(out, header + "_STLB_MISSES", s_stlb_misses_);
+    PRINT_STAT(out, header + "_PAGE_WALKS", s_walks_);
+    PRINT_STAT(out, header + "_PAGE_WALK_LOADS", s_walk_loads_);
+    PRINT_STAT(out, header + "_PWC_HITS", s_pwc_hits_);
+    PRINT_STAT(out, header + "_AVG_WALK_LATENCY", avg_walk_latency);
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+bool
+MMU::lookup(TLB& tlb, uint64_t vpn, size_t* level) {
+    if (tlb.probe(tlb_key(vpn, 0))) {
+        if (level != nullptr) *level = 0;
+        return true;
+    }
+    if (GL_os_->conf_.thp_policy != THPPolicy::NEVER) {
+        size_t lvl = GL_os_->conf_.thp_level;
+        if (tlb.probe(tlb_key(vpn, lvl))) {
+            if (level != nullptr) *level = lvl;
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+MMU::start_walk(uint64_t vpn) {
+    ++s_walks_;
+    walk_active_ = true;
+    walk_vpn_ = vpn;
+    walk_begin_ = GL_cycle_;
+    walk_step_ready_ = GL_cycle_;
+    walk_leaf_level_ = GL_os_->get_walk(vpn, walk_pte_lineaddr_);
+    // Start below the deepest level whose entry is in the page walk cache.
+    walk_loads_left_ = PT_LEVELS - walk_leaf_level_;
+    for (size_t lvl = walk_leaf_level_+1; lvl < PT_LEVELS; lvl++) {
+        if (pwc_[lvl-1].probe(vpn >> (lvl*PT_BITS_PER_LEVEL))) {
+            ++s_pwc_hits_;
+            walk_loads_left_ = lvl - walk_leaf_level_;
+            break;
+        }
+    }
+}
+
+void
+MMU::finish_walk() {
+    for (size_t lvl = walk_leaf_level_+1; lvl < PT_LEVELS; lvl++) {
+        pwc_[lvl-1].fill(walk_vpn_ >> (lvl*PT_BITS_PER_LEVEL));
+    }
+    uint64_t k = tlb_key(walk_vpn_, walk_leaf_level_);
+    stlb_.fill(k);
+    dtlb_.fill(k);
+
+    s_tot_walk_latency_ += GL_cycle_ - walk_begin_;
+    walk_active_ = false;
+    walk_done_ = true;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
@@ -0,0 +1,183 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#ifndef MMU_h
+#define MMU_h
+
+#include "defs.h"
+#include "os.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * Page walk loads are sent to the LLC with this ROB id, so that
+ * `LLC2Controller::update_prev_level` can hand their completion to the MMU.
+ * */
+constexpr size_t MMU_ROBID = ROB_WIDTH;
+
+constexpr size_t DTLB_ASSOC = 4;
+constexpr size_t STLB_ASSOC = 12;
+constexpr size_t PWC_ASSOC = 4;
+
+constexpr uint64_t STLB_LATENCY = 8;
+
+/*
+ * Sizes are in entries (`pwc_entries_` is per page table level). With
+ * `perfect_` set (the default), translation is free: no TLBs, no page walks.
+ * */
+struct MMUConfig {
+    size_t dtlb_entries_ =64;
+    size_t stlb_entries_ =1536;
+    size_t pwc_entries_ =32;
+    bool   perfect_ =true;
+};
+
+/*
+ * TLB key of the page at page table level `level` that contains `vpn`. The
+ * level goes in the top bits (VPNs, ASID included, are below 2^58), so that
+ * the set is picked by the page number alone.
+ * */
+inline uint64_t
+tlb_key(uint64_t vpn, size_t level) {
+    return (vpn >> (level*PT_BITS_PER_LEVEL)) | (static_cast<uint64_t>(level) << 62);
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * Set-associative LRU array of keys: only hits and misses are modeled, the
+ * translation itself always comes from `OS::v2p`.
+ * */
+class TLB {
+private:
+    size_t sets_;
+    size_t ways_;
+
+    std::vector<uint64_t> keys_;
+    std::vector<uint64_t> lru_timestamps_;
+    uint64_t access_ctr_ =0;
+public:
+    TLB(size_t entries, size_t ways);
+    /*
+     * `probe` updates the LRU state on a hit; `fill` evicts the LRU key of
+     * the set.
+     * */
+    bool probe(uint64_t key);
+    void fill(uint64_t key);
+    /*
+     * Returns true if `key` was in the array.
+     * */
+    bool invalidate(uint64_t key);
+    /*
+     * Drops the keys in [`first`, `first+count`). Returns true if any was in
+     * the array.
+     * */
+    bool invalidate_range(uint64_t first, uint64_t count);
+    void flush(void);
+
+    size_t valid_entries(void) const;
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * Per-core MMU: an L1 dTLB, an L2 STLB, and a page walk cache for each
+ * interior page table level. TLB entries are tagged with their page size, so
+ * a huge page (see `THPPolicy`) covers its whole region.
+ *
+ * A miss in both TLBs starts a page walk. The walk skips the levels covered
+ * by the deepest page walk cache hit, and then reads one entry per level
+ * through `LLC2Controller::access`, each read waiting for the previous one.
+ * The entries are at the physical addresses `OS::get_walk` reports, so walks
+ * can hit in the LLC or go to DRAM.
+ * */
+class MMU {
+public:
+    uint64_t s_accesses_ =0;
+    uint64_t s_dtlb_misses_ =0;
+    uint64_t s_stlb_misses_ =0;
+    uint64_t s_pwc_hits_ =0;
+    uint64_t s_walks_ =0;
+    uint64_t s_walk_loads_ =0;
+    uint64_t s_tot_walk_latency_ =0;
+private:
+    const size_t coreid_;
+    const MMUConfig conf_;
+
+    TLB dtlb_;
+    TLB stlb_;
+    /*
+     * `pwc_[i]` caches entries of page table level i+1.
+     * */
+    std::vector<TLB> pwc_;
+    /*
+     * The page walk in flight: `walk_loads_left_` entries remain to be read,
+     * down to `walk_leaf_level_`, and the next one can be read at
+     * `walk_step_ready_`. `walk_done_` is set once the walk for `walk_vpn_`
+     * is over, until another page is translated.
+     * */
+    bool     walk_active_ =false;
+    bool     walk_done_ =false;
+    bool     walk_load_in_flight_ =false;
+    uint64_t walk_vpn_;
+    uint64_t walk_begin_;
+    uint64_t walk_step_ready_;
+    size_t   walk_loads_left_;
+    size_t   walk_leaf_level_;
+    uint64_t walk_pte_lineaddr_[PT_LEVELS];
+public:
+    MMU(size_t coreid, const MMUConfig&);
+
+    void tick(void);
+    /*
+     * Returns false while `vpn` cannot be translated (a page walk has been
+     * started for it). Otherwise, `begin` is the cycle translation started
+     * (before a page walk, if there was one), and `latency` the cycles it
+     * still takes.
+     * */
+    bool translate(uint64_t vpn, uint64_t& begin, uint64_t& latency);
+    /*
+     * Called when the entry read by the current walk step is available at
+     * cycle `when`.
+     * */
+    void walk_step_done(uint64_t when);
+    /*
+     * Empties the TLBs and page walk caches (context switch).
+     * */
+    void flush(void);
+    /*
+     * Drops the base page `vpn` from the TLBs (TLB shootdown, see
+     * `OS::move_page`). Returns true if either TLB had it.
+     * */
+    bool invalidate(uint64_t vpn);
+    /*
+     * Drops every translation in the page table level `level` region that
+     * starts at `first_vpn`, and the page walk cache entries that lead into it
+     * (THP promotion, see `OS::promote_huge_page`). Returns true if either TLB
+     * had any of the base pages.
+     * */
+    bool invalidate_region(uint64_t first_vpn, size_t level);
+
+    void print_stats(std::ostream&, std::string header);
+private:
+    /*
+     * Probes `tlb` for each page size in use; `level` is set to the page
+     * table level of the hit.
+     * */
+    bool lookup(TLB&, uint64_t vpn, size_t* level =nullptr);
+    void start_walk(uint64_t vpn);
+    void finish_walk(void);
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+#endif  // MMU_h
@@ -4,26 +4,82 @@
  * */
 
 #include "os.h"
-#include "utils/bitcount.h"
+#include "core.h"
+#include "dram/address.h"
+#include "utils/fastdiv.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include <stdlib.h>
 #include <string.h>
 
-constexpr size_t RAND_MAP_TRIES = 2048;
-
-OS::OS(uint64_t dram_size_mb)
-    :num_frames_( (1024*1024*dram_size_mb) / OS_PAGESIZE )
+OS::OS(uint64_t dram_size_mb, const OSConfig& conf)
+    :num_frames_( (1024*1024*dram_size_mb) / OS_PAGESIZE ),
+    conf_(conf),
+    rmap_(num_frames_)
 {
-    avail_frames_ = new uint64_t[num_frames_ >> 6];
-    memset(avail_frames_, 0, sizeof(uint64_t)*(num_frames_>>6));
+    pt_nodes_.emplace_back();  // Node 0: the "not present" node.
 
-    avail_frames_[0] = 1;  // Do not allocate page-0 to anyone.
+    if (conf.tiers.near_mb == 0) {
+        frame_allocator_ = make_frame_allocator(conf.frame_alloc_policy, num_frames_);
+        return;
+    }
+    uint64_t near_frames = (1024*1024*conf.tiers.near_mb) / OS_PAGESIZE;
+    if (near_frames >= num_frames_) {
+        std::cerr << "OS: near tier (" << conf.tiers.near_mb << " MB) must be smaller than memory ("
+            << dram_size_mb << " MB).\n";
+        exit(1);
+    }
+    frame_allocator_ = make_frame_allocator(conf.frame_alloc_policy, near_frames);
+    far_frame_allocator_ = make_frame_allocator(conf.frame_alloc_policy, num_frames_ - near_frames);
+    tiers_ = new MemoryTiers(conf.tiers, near_frames);
+    next_migration_cycle_ = conf.tiers.migrate_epoch;
 }
 
 OS::~OS() {
-    delete[] avail_frames_;
+    for (Process* p : procs_) {
+        delete p;
+    }
+    delete frame_allocator_;
+    if (tiers_ != nullptr) {
+        delete far_frame_allocator_;
+        delete tiers_;
+    }
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+OS::tick() {
+    if (tiers_ == nullptr) {
+        return;
+    }
+    tiers_->tick();
+    if (GL_cycle_ >= next_migration_cycle_) {
+        migrate_pages();
+        next_migration_cycle_ += conf_.tiers.migrate_epoch;
+    }
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+OS::add_process(std::string trace_file, size_t coreid) {
+    Process* p = new Process(procs_.size(), coreid, trace_file);
+    procs_.push_back(p);
+    run_queues_[coreid].push_back(p);
+}
+
+Process*
+OS::schedule(size_t coreid) {
+    auto& q = run_queues_[coreid];
+    Process* p = q.front();
+    q.pop_front();
+    q.push_back(p);
+    return p;
 }
 
 ////////////////////////////////////////////////////////////////
@@ -33,29 +89,301 @@ uint64_t
 OS::p2v(uint64_t lineaddr) {
     uint64_t pfn, off;
     get_page_and_offset(lineaddr, pfn, off);
-    return join_page_and_offset( pfn_to_vpn_.at(pfn), off );
+    uint64_t vpn = rmap_.get(pfn);
+    if (vpn == ReverseMap::NONE) {
+        std::cerr << "OS::p2v: frame " << pfn << " is not mapped.\n";
+        exit(1);
+    }
+    return join_page_and_offset(vpn, off);
+}
+
+void
+OS::pages_in_rows(size_t ch, size_t sc, size_t rank, size_t bg, size_t bank,
+                    uint64_t row_first, uint64_t row_last,
+                    std::vector<RowPage>& out) const
+{
+    for (uint64_t row = row_first; row <= row_last; row++) {
+        size_t first = out.size();
+        for (uint64_t col = 0; col < NUM_COLUMNS; col++) {
+            uint64_t pfn = FastDiv<LINES_PER_PAGE>::div(LINEADDR(ch, sc, rank, bg, bank, row, col));
+            if (pfn >= num_frames_) {
+                break;  // Columns only grow the address.
+            }
+            uint64_t vpn = rmap_.get(pfn);
+            if (vpn == ReverseMap::NONE) {
+                continue;
+            }
+            // A page's lines in a row are found together.
+            if (out.size() > first && out.back().pfn_ == pfn) {
+                continue;
+            }
+            size_t asid = ASID_OF_VA(join_page_and_offset(vpn, 0));
+            out.push_back({ row, pfn, vpn, asid, procs_.at(asid)->coreid_ });
+        }
+    }
 }
 
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 
 uint64_t
-OS::v2p(uint64_t lineaddr) {
+OS::v2p(uint64_t lineaddr, size_t coreid) {
     uint64_t vpn, off;
     get_page_and_offset(lineaddr, vpn, off);
 
-    if (!vpn_to_page_.count(vpn)) {
-        // Make new virtual page.
-        OSPage pg;
+    TranslationCacheEntry& e = tc_[coreid][MOD_BY_POW2(vpn, OS_TC_ENTRIES)];
+    if (e.vpn_ != vpn) {
+        ++s_tc_misses_;
+        e.vpn_ = vpn;
+        e.pfn_ = translate(vpn);
+    }
+    return join_page_and_offset( e.pfn_, off );
+}
+
+uint64_t
+OS::translate(uint64_t vpn) {
+    uint64_t pfn = walk(vpn);
+    if (pfn != 0) {
+        return pfn;
+    }
+
+    if (conf_.thp_policy == THPPolicy::ALWAYS && map_huge_page(vpn)) {
+        return walk(vpn);
+    }
+    // Make new virtual page.
+    pfn = map_page(vpn);
+    pte(vpn) = pfn;
+    ++s_virtual_pages_;
+    vpn_to_page_[vpn].pfn_ = pfn;
+    rmap_.set(pfn, vpn);
+    if (conf_.thp_policy == THPPolicy::PROMOTE) {
+        uint64_t region = pte(vpn, conf_.thp_level);
+        if (++pt_nodes_[region].num_mapped_ >= conf_.thp_promote_pages && promote_huge_page(vpn)) {
+            return walk(vpn);
+        }
+    }
+    return pfn;
+}
+
+uint64_t
+OS::walk(uint64_t vpn) const {
+    auto root_it = pt_roots_.find(vpn >> PT_VPN_BITS);
+    if (root_it == pt_roots_.end()) {
+        return 0;
+    }
+    // Missing nodes lead to node 0, so this reads 0 at the leaf.
+    uint64_t node = root_it->second;
+    for (size_t lvl = PT_LEVELS-1; lvl > 0; lvl--) {
+        size_t ii = (vpn >> (lvl*PT_BITS_PER_LEVEL)) & (PT_ENTRIES-1);
+        uint64_t e = pt_nodes_[node].entries_[ii];
+        if (e & PTE_HUGE) {
+            return (e & ~PTE_HUGE) | (vpn & ((1ULL << (lvl*PT_BITS_PER_LEVEL))-1));
+        }
+        node = e;
+    }
+    return pt_nodes_[node].entries_[vpn & (PT_ENTRIES-1)];
+}
+
+size_t
+OS::get_walk(uint64_t vpn, uint64_t pte_lineaddr[PT_LEVELS]) {
+    translate(vpn);
+
+    constexpr size_t PTES_PER_LINE = LINESIZE/sizeof(uint64_t);
+    uint64_t node = pt_roots_.at(vpn >> PT_VPN_BITS);
+    for (size_t lvl = PT_LEVELS-1; ; lvl--) {
+        size_t ii = (vpn >> (lvl*PT_BITS_PER_LEVEL)) & (PT_ENTRIES-1);
+        pte_lineaddr[lvl] = join_page_and_offset(pt_nodes_[node].pfn_, ii/PTES_PER_LINE);
+
+        uint64_t e = pt_nodes_[node].entries_[ii];
+        if (lvl == 0 || (e & PTE_HUGE)) {
+            return lvl;
+        }
+        node = e;
+    }
+}
+
 #ifdef COMPRESSION_TRACES
-        memset(pg.data_, 0, 4096);
+
+void
+OS::read_line(uint64_t lineaddr, char data[LINESIZE]) {
+    uint64_t vpn, off;
+    get_page_and_offset(lineaddr, vpn, off);
+    OSPage& pg = get_page(vpn);
+    memmove(data, page_data_.get(pg.data_) + off*LINESIZE, LINESIZE);
+}
+
+void
+OS::write_line(uint64_t lineaddr, const char data[LINESIZE]) {
+    uint64_t vpn, off;
+    get_page_and_offset(lineaddr, vpn, off);
+    OSPage& pg = get_page(vpn);
+
+    static const char ZERO_LINE[LINESIZE] {};
+    bool is_zero = memcmp(data, ZERO_LINE, LINESIZE) == 0;
+    if (pg.data_ == PAGE_DATA_ZERO && is_zero) {
+        return;
+    }
+    char* pgdata = page_data_.writable(pg.data_);
+    memmove(pgdata + off*LINESIZE, data, LINESIZE);
+    // Go back to the zero page if the page is all zeros again.
+    if (is_zero) {
+        for (size_t i = 0; i < LINES_PER_PAGE; i++) {
+            if (memcmp(pgdata + i*LINESIZE, ZERO_LINE, LINESIZE) != 0) {
+                return;
+            }
+        }
+        page_data_.release(pg.data_);
+    }
+}
+
 #endif
-        map_page(pg);
-        vpn_to_page_[vpn] = pg;
-        ++s_virtual_pages_;
+
+void
+OS::note_memory_access(uint64_t lineaddr, bool is_read) {
+    uint64_t vpn = rmap_.get(FastDiv<LINES_PER_PAGE>::div(lineaddr));
+    if (vpn == ReverseMap::NONE) {
+        return;  // Page table nodes.
+    }
+    auto it = vpn_to_page_.find(vpn);
+    if (it == vpn_to_page_.end()) {
+        return;  // Huge pages.
+    }
+    OSPage& pg = it->second;
+    if (is_read) ++pg.s_reads_;
+    else         ++pg.s_writes_;
+}
+
+OSPage&
+OS::get_page(uint64_t vpn) {
+    auto it = vpn_to_page_.find(vpn);
+    if (it == vpn_to_page_.end()) {
+        it = vpn_to_page_.emplace(vpn, OSPage{ walk(vpn) }).first;
+    }
+    return it->second;
+}
+
+uint64_t&
+OS::pte(uint64_t vpn, size_t level) {
+    auto root_it = pt_roots_.find(vpn >> PT_VPN_BITS);
+    if (root_it == pt_roots_.end()) {
+        root_it = pt_roots_.emplace(vpn >> PT_VPN_BITS, new_pt_node()).first;
+    }
+    // Indices only: `new_pt_node` may move the nodes.
+    uint64_t node = root_it->second;
+    for (size_t lvl = PT_LEVELS-1; lvl > level; lvl--) {
+        size_t ii = (vpn >> (lvl*PT_BITS_PER_LEVEL)) & (PT_ENTRIES-1);
+        if (pt_nodes_[node].entries_[ii] == 0) {
+            uint64_t next = new_pt_node();
+            pt_nodes_[node].entries_[ii] = next;
+        }
+        node = pt_nodes_[node].entries_[ii];
+    }
+    size_t ii = (vpn >> (level*PT_BITS_PER_LEVEL)) & (PT_ENTRIES-1);
+    return pt_nodes_[node].entries_[ii];
+}
+
+uint64_t
+OS::new_pt_node() {
+    uint64_t node;
+    if (!pt_free_nodes_.empty()) {
+        node = pt_free_nodes_.back();
+        pt_free_nodes_.pop_back();
+    } else {
+        pt_nodes_.emplace_back();
+        node = pt_nodes_.size()-1;
+    }
+    uint64_t pfn = alloc_frame(0);
+    if (pfn == 0) {
+        std::cerr << "Failed to map page table node (total frames = " << num_frames_ << ").\n";
+        exit(1);
+    }
+    pt_nodes_[node].pfn_ = pfn;
+    return node;
+}
+
+void
+OS::free_pt_subtree(uint64_t node, size_t level) {
+    for (uint64_t e : pt_nodes_[node].entries_) {
+        if (e == 0) {
+            continue;
+        }
+        if (level == 0) {
+            rmap_.clear(e);
+            free_frame(e);
+        } else {
+            free_pt_subtree(e, level-1);
+        }
+    }
+    free_frame(pt_nodes_[node].pfn_);
+    pt_nodes_[node] = PageTableNode();
+    pt_free_nodes_.push_back(node);
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+bool
+OS::map_huge_page(uint64_t vpn) {
+    const size_t order = conf_.thp_level*PT_BITS_PER_LEVEL;
+
+    if (pte(vpn, conf_.thp_level) != 0) {
+        return false;
+    }
+    uint64_t pfn = alloc_block(order);
+    if (pfn == 0) {
+        ++s_thp_fallbacks_;
+        return false;
+    }
+    pte(vpn, conf_.thp_level) = PTE_HUGE | pfn;
+    rmap_.set(pfn, (vpn >> order) << order, 1ULL << order);
+    ++s_page_faults_;
+    ++s_huge_pages_;
+    return true;
+}
+
+bool
+OS::promote_huge_page(uint64_t vpn) {
+    const size_t order = conf_.thp_level*PT_BITS_PER_LEVEL;
+
+    uint64_t pfn = alloc_block(order);
+    if (pfn == 0) {
+        ++s_thp_fallbacks_;
+        return false;
+    }
+    // The base pages' contents are copied over: free their frames and nodes.
+    const uint64_t first_vpn = (vpn >> order) << order;
+    uint64_t& e = pte(vpn, conf_.thp_level);
+    free_pt_subtree(e, conf_.thp_level-1);
+    e = PTE_HUGE | pfn;
+    rmap_.set(pfn, first_vpn, 1ULL << order);
+    // The base pages keep their counters (and contents), at their new frames.
+    for (uint64_t i = 0; i < (1ULL << order); i++) {
+        auto it = vpn_to_page_.find(first_vpn + i);
+        if (it != vpn_to_page_.end()) {
+            it->second.pfn_ = pfn + i;
+        }
+    }
+    invalidate_tc(first_vpn, 1ULL << order);
+    for (size_t i = 0; i < N_THREADS; i++) {
+        if (GL_cores_[i]->mmu_.invalidate_region(first_vpn, conf_.thp_level)) {
+            GL_cores_[i]->tlb_shootdown(TLB_SHOOTDOWN_CYCLES);
+            ++s_tlb_shootdowns_;
+        }
+    }
+    ++s_huge_pages_;
+    ++s_thp_promotions_;
+    return true;
+}
+
+void
+OS::invalidate_tc(uint64_t first_vpn, uint64_t num_pages) {
+    for (size_t i = 0; i < N_THREADS; i++) {
+        for (TranslationCacheEntry& e : tc_[i]) {
+            if (e.vpn_ - first_vpn < num_pages) {
+                e = TranslationCacheEntry();
+            }
+        }
     }
-    const OSPage& pg = vpn_to_page_.at(vpn);
-    return join_page_and_offset( pg.pfn_, off );
 }
 
 ////////////////////////////////////////////////////////////////
@@ -65,27 +393,216 @@ void
 OS::print_stats(std::ostream& out) {
     PRINT_STAT(out, "OS_MAPPED_PAGES", s_virtual_pages_);
     PRINT_STAT(out, "OS_TOTAL_PAGE_FRAMES", num_frames_);
+    PRINT_STAT(out, "OS_FRAME_ALLOC_POLICY", frame_alloc_policy_name(conf_.frame_alloc_policy));
+    PRINT_STAT(out, "OS_PAGE_TABLE_NODES", pt_nodes_.size()-1-pt_free_nodes_.size());
+    PRINT_STAT(out, "OS_TC_MISSES", s_tc_misses_);
+    PRINT_STAT(out, "OS_RMAP_KB", rmap_.size_in_bytes() >> 10);
+    if (conf_.thp_policy != THPPolicy::NEVER) {
+        PRINT_STAT(out, "OS_HUGE_PAGES", s_huge_pages_);
+        PRINT_STAT(out, "OS_THP_PROMOTIONS", s_thp_promotions_);
+        PRINT_STAT(out, "OS_THP_FALLBACKS", s_thp_fallbacks_);
+    }
+    if (tiers_ != nullptr || conf_.thp_policy == THPPolicy::PROMOTE) {
+        PRINT_STAT(out, "OS_TLB_SHOOTDOWNS", s_tlb_shootdowns_);
+    }
+    frame_allocator_->print_stats(out);
+    if (conf_.procs_per_core > 1) {
+        for (Process* p : procs_) {
+            std::string header = "PROC_" + std::to_string(p->asid_);
+            PRINT_STAT(out, header + "_CORE", p->coreid_);
+            PRINT_STAT(out, header + "_INST", p->s_inst_);
+            PRINT_STAT(out, header + "_SLICES", p->s_slices_);
+        }
+    }
+    if (tiers_ != nullptr) {
+        PRINT_STAT(out, "OS_FAR_FRAMES", s_far_frames_);
+        PRINT_STAT(out, "OS_PROMOTIONS", s_promotions_);
+        PRINT_STAT(out, "OS_DEMOTIONS", s_demotions_);
+        tiers_->print_stats(out);
+    }
+#ifdef COMPRESSION_TRACES
+    page_data_.print_stats(out);
+#endif
     out << "\n";
 }
 
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 
-void
-OS::map_page(OSPage& pg) {
+uint64_t
+OS::map_page(uint64_t vpn) {
     ++s_page_faults_;
-    for (size_t i = 0; i < RAND_MAP_TRIES; i++) {
-        uint64_t pfn = rand() % num_frames_;
+    uint64_t pfn = alloc_frame(vpn);
+    if (pfn == 0) {
+        std::cerr << "Failed to map page (total frames = " << num_frames_ << ").\n";
+        exit(1);
+    }
+    return pfn;
+}
+
+uint64_t
+OS::alloc_frame(uint64_t vpn) {
+    uint64_t pfn = frame_allocator_->alloc(vpn);
+    if (pfn != 0 || tiers_ == nullptr) {
+        return pfn;
+    }
+    pfn = far_frame_allocator_->alloc(vpn);
+    if (pfn == 0) {
+        return 0;
+    }
+    ++s_far_frames_;
+    return tiers_->near_frames_ + pfn;
+}
+
+void
+OS::free_frame(uint64_t pfn) {
+    if (tiers_ != nullptr && pfn >= tiers_->near_frames_) {
+        --s_far_frames_;
+        far_frame_allocator_->free(pfn - tiers_->near_frames_);
+    } else {
+        frame_allocator_->free(pfn);
+    }
+}
+
+uint64_t
+OS::alloc_block(size_t order) {
+    uint64_t pfn = frame_allocator_->alloc_block(order);
+    if (pfn != 0 || tiers_ == nullptr) {
+        return pfn;
+    }
+    pfn = far_frame_allocator_->alloc_block(order);
+    if (pfn == 0) {
+        return 0;
+    }
+    s_far_frames_ += 1ULL << order;
+    return tiers_->near_frames_ + pfn;
+}
+
+void
+OS::free_block(uint64_t pfn, size_t order) {
+    if (tiers_ != nullptr && pfn >= tiers_->near_frames_) {
+        s_far_frames_ -= 1ULL << order;
+        far_frame_allocator_->free_block(pfn - tiers_->near_frames_, order);
+    } else {
+        frame_allocator_->free_block(pfn, order);
+    }
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+OS::migrate_pages() {
+    const uint64_t near_frames = tiers_->near_frames_;
+    // Hot far pages, hottest first, and near pages, coldest first.
+    std::vector<std::pair<uint64_t, uint64_t>> hot, cold;
+    for (auto& [vpn, pg] : vpn_to_page_) {
+        uint64_t n = pg.s_reads_ + pg.s_writes_;
+        if (pg.pfn_ >= near_frames) {
+            if (n >= conf_.tiers.hot_threshold) hot.emplace_back(n, vpn);
+        } else {
+            cold.emplace_back(n, vpn);
+        }
+    }
+    std::sort(hot.begin(), hot.end(), std::greater<>());
+    std::sort(cold.begin(), cold.end());
 
-        size_t ii = pfn >> 6;
-        size_t off = pfn & 63;
-        if ( !(avail_frames_[ii] & (1L<<off)) ) {
-            avail_frames_[ii] |= (1L<<off);
-            pg.pfn_ = pfn;
-            return;
+    size_t num_promoted = 0;
+    auto cold_it = cold.begin();
+    for (auto [n, vpn] : hot) {
+        if (num_promoted == conf_.tiers.migrate_pages) {
+            break;
         }
+        if (is_huge_mapped(vpn)) {
+            continue;
+        }
+        OSPage& pg = vpn_to_page_.at(vpn);
+        uint64_t near_pfn = frame_allocator_->alloc(vpn);
+        if (near_pfn == 0) {
+            // Demote the coldest near page that is colder than `vpn`, and copy
+            // `vpn` into its frame once it has been copied out.
+            while (cold_it != cold.end() && cold_it->first < n && is_huge_mapped(cold_it->second)) {
+                ++cold_it;
+            }
+            if (cold_it == cold.end() || cold_it->first >= n) {
+                break;
+            }
+            uint64_t far_pfn = far_frame_allocator_->alloc(cold_it->second);
+            if (far_pfn == 0) {
+                break;
+            }
+            ++s_far_frames_;
+            OSPage& cold_pg = vpn_to_page_.at(cold_it->second);
+            near_pfn = cold_pg.pfn_;
+            move_page(cold_it->second, cold_pg, near_frames + far_pfn, false);
+            ++s_demotions_;
+            ++cold_it;
+        }
+        move_page(vpn, pg, near_pfn);
+        ++s_promotions_;
+        ++num_promoted;
+    }
+    // One shootdown for the whole epoch, on the cores that need it.
+    for (size_t i = 0; i < N_THREADS; i++) {
+        if (shootdown_cores_[i]) {
+            GL_cores_[i]->tlb_shootdown(TLB_SHOOTDOWN_CYCLES);
+            shootdown_cores_[i] = false;
+            ++s_tlb_shootdowns_;
+        }
+    }
+    // Age the counters.
+    for (auto& [vpn, pg] : vpn_to_page_) {
+        pg.s_reads_ >>= 1;
+        pg.s_writes_ >>= 1;
     }
-    std::cerr << "Failed to map page (total frames = " << num_frames_ << ").\n";
+}
+
+void
+OS::move_page(uint64_t vpn, OSPage& pg, uint64_t pfn, bool free_old) {
+    uint64_t old_pfn = pg.pfn_;
+    tiers_->copy_page(old_pfn, pfn, free_old);
+
+    pte(vpn) = pfn;
+    pg.pfn_ = pfn;
+    rmap_.clear(old_pfn);
+    rmap_.set(pfn, vpn);
+    invalidate_tc(vpn, 1);
+    for (size_t i = 0; i < N_THREADS; i++) {
+        if (GL_cores_[i]->mmu_.invalidate(vpn)) {
+            shootdown_cores_[i] = true;
+        }
+    }
+}
+
+void
+OS::free_moved_frame(uint64_t pfn) {
+    free_frame(pfn);
+}
+
+bool
+OS::is_huge_mapped(uint64_t vpn) {
+    return conf_.thp_policy != THPPolicy::NEVER && (pte(vpn, conf_.thp_level) & PTE_HUGE);
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+THPPolicy
+thp_policy_from_name(std::string name) {
+    for (THPPolicy p : { THPPolicy::NEVER, THPPolicy::ALWAYS, THPPolicy::PROMOTE }) {
+        if (thp_policy_name(p) == name) {
+            return p;
+        }
+    }
+    std::cerr << "thp_policy_from_name: unknown THP policy \"" << name << "\".\n";
+    exit(1);
+}
+
+size_t
+thp_level_from_size(std::string size) {
+    if (size == "2M") return 1;
+    if (size == "1G") return 2;
+    std::cerr << "thp_level_from_size: huge pages are \"2M\" or \"1G\", not \"" << size << "\".\n";
     exit(1);
 }
 
@@ -94,13 +611,12 @@ OS::map_page(OSPage& pg) {
 
 void
 get_page_and_offset(uint64_t lineaddr, uint64_t& p, uint64_t& off) {
-    p = lineaddr >> Log2<LINES_PER_PAGE>::value;
-    off = lineaddr & (LINES_PER_PAGE-1);
+    FastDiv<LINES_PER_PAGE>::divmod(lineaddr, p, off);
 }
 
 uint64_t
 join_page_and_offset(uint64_t p, uint64_t off) {
-    return (p << Log2<LINES_PER_PAGE>::value) | off;
+    return p*LINES_PER_PAGE + off;
 }
 
 ////////////////////////////////////////////////////////////////
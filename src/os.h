@@ -7,8 +7,17 @@
 #define OS_h
 
 #include "defs.h"
+#include "os/frame_allocator.h"
+#include "os/page_data.h"
+#include "os/process.h"
+#include "os/reverse_map.h"
+#include "os/tiering.h"
 
+#include <array>
+#include <deque>
 #include <iostream>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -17,15 +26,134 @@
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 
+/*
+ * Transparent huge pages:
+ *  NEVER:      only base (4 KB) pages are mapped.
+ *  ALWAYS:     the first fault in a huge region maps the whole region.
+ *  PROMOTE:    like khugepaged, a region is remapped as a huge page once
+ *              `thp_promote_pages` of its base pages are mapped.
+ * Huge frames come from `FrameAllocator::alloc_block`; when there is no free
+ * block (or the allocation policy has no blocks, only `buddy` does), base
+ * pages are used instead.
+ * */
+enum class THPPolicy { NEVER, ALWAYS, PROMOTE };
+
+inline std::string_view
+thp_policy_name(THPPolicy p) {
+    if (p == THPPolicy::NEVER)      return "never";
+    if (p == THPPolicy::ALWAYS)     return "always";
+    if (p == THPPolicy::PROMOTE)    return "promote";
+    return "unknown";
+}
+
+/*
+ * Inverses of `thp_policy_name` and of the huge page size names ("2M", "1G"),
+ * which map to a page table level (see `OSConfig`). Both exit on bad input.
+ * */
+THPPolicy thp_policy_from_name(std::string);
+size_t    thp_level_from_size(std::string);
+
+struct OSConfig {
+    FrameAllocPolicy frame_alloc_policy =FrameAllocPolicy::RANDOM;
+
+    THPPolicy thp_policy =THPPolicy::NEVER;
+    /*
+     * Page table level of huge mappings: 1 maps 2 MB pages, 2 maps 1 GB pages.
+     * */
+    size_t   thp_level =1;
+    uint64_t thp_promote_pages =256;
+
+    TierConfig tiers;
+    /*
+     * Scheduling: each core time-slices `procs_per_core` processes, and
+     * switches every `quantum` cycles. A switch stalls the core for
+     * `ctx_switch_cycles`, and also flushes its TLBs if `ctx_flush_tlb` is
+     * set (otherwise, ASIDs keep the entries apart).
+     * */
+    size_t   procs_per_core =1;
+    uint64_t quantum =4'000'000;
+    uint64_t ctx_switch_cycles =8'000;
+    bool     ctx_flush_tlb =false;
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+/*
+ * `s_reads_` and `s_writes_` count memory (LLC miss and writeback) accesses
+ * to the page. They are only kept with tiering (see `TierConfig`), and are
+ * halved every migration epoch.
+ * */
 struct OSPage {
     uint64_t pfn_;
+    uint32_t s_reads_ =0;
+    uint32_t s_writes_ =0;
 #ifdef COMPRESSION_TRACES
-    char data_[4096];
-    uint64_t s_reads_;
-    uint64_t s_writes_;
+    /*
+     * Handle into `OS::page_data_`: the contents are not stored inline.
+     * */
+    uint32_t data_ =PAGE_DATA_ZERO;
 #endif
 };
 
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * The page table is a radix tree like x86-64's: `PT_LEVELS` levels of
+ * `PT_ENTRIES` entries, which cover the low `PT_VPN_BITS` bits of a VPN. The
+ * bits above that (the ASID, see `TAG_VA_WITH_ASID`) pick the root, so each
+ * process has its own tree.
+ *
+ * Interior entries are indices of the next level's node and leaf entries are
+ * PFNs. Node 0 is all zeros and is never written, so an entry of 0 means "not
+ * present" at every level (frame 0 is never handed out either).
+ *
+ * An interior entry with `PTE_HUGE` set maps a huge page instead: the rest of
+ * the entry is the first PFN of the 2^(9*level) frames it covers.
+ * */
+constexpr size_t PT_LEVELS = 4;
+constexpr size_t PT_BITS_PER_LEVEL = 9;
+constexpr size_t PT_ENTRIES = 1L << PT_BITS_PER_LEVEL;
+constexpr size_t PT_VPN_BITS = PT_LEVELS*PT_BITS_PER_LEVEL;
+
+constexpr uint64_t PTE_HUGE = 1ULL << 63;
+
+struct PageTableNode {
+    std::array<uint64_t, PT_ENTRIES> entries_ {};
+    /*
+     * Frame holding this node, so page walks read real physical addresses.
+     * */
+    uint64_t pfn_ =0;
+    /*
+     * THP PROMOTE: base pages mapped below this node, for nodes just below
+     * the huge page level.
+     * */
+    uint64_t num_mapped_ =0;
+};
+/*
+ * Each core has a direct-mapped translation cache in front of the page table.
+ * Entries are invalidated when their page is remapped (THP promotion).
+ * */
+constexpr size_t OS_TC_ENTRIES = 256;
+
+struct TranslationCacheEntry {
+    uint64_t vpn_ =~0ULL;
+    uint64_t pfn_ =0;
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * A mapped page with lines in a DRAM row (see `OS::pages_in_rows`).
+ * */
+struct RowPage {
+    uint64_t row_;
+    uint64_t pfn_;
+    uint64_t vpn_;
+    size_t   asid_;
+    size_t   coreid_;
+};
+
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 
@@ -33,25 +161,166 @@ class OS {
 public:
     const uint64_t num_frames_;
 
+    const OSConfig conf_;
+
     uint64_t s_virtual_pages_ =0;
     uint64_t s_page_faults_   =0;
+    uint64_t s_tc_misses_     =0;
+    uint64_t s_huge_pages_    =0;
+    uint64_t s_thp_promotions_ =0;
+    uint64_t s_thp_fallbacks_ =0;
+    uint64_t s_far_frames_     =0;
+    uint64_t s_promotions_    =0;
+    uint64_t s_demotions_     =0;
+    uint64_t s_tlb_shootdowns_ =0;
+    /*
+     * Null unless tiering is enabled.
+     * */
+    MemoryTiers* tiers_ =nullptr;
 private:
-    std::unordered_map<uint64_t, uint64_t> pfn_to_vpn_;
+    std::vector<Process*> procs_;
+    std::deque<Process*>  run_queues_[N_THREADS];
+
+    ReverseMap rmap_;
+    /*
+     * Huge mappings have no entry per base page (but see `get_page`), except
+     * for the base pages a promotion replaced.
+     * */
     std::unordered_map<uint64_t, OSPage> vpn_to_page_;
+#ifdef COMPRESSION_TRACES
+    PageDataStore page_data_;
+#endif
+    /*
+     * Page table nodes (see `PageTableNode`), the root node of each
+     * `vpn >> PT_VPN_BITS`, and nodes released by THP promotion.
+     * */
+    std::vector<PageTableNode> pt_nodes_;
+    std::unordered_map<uint64_t, uint64_t> pt_roots_;
+    std::vector<uint64_t> pt_free_nodes_;
+
+    TranslationCacheEntry tc_[N_THREADS][OS_TC_ENTRIES];
     /*
-     * Bitvector of available page frames.
+     * With tiering, `frame_allocator_` only has the near tier's frames, and
+     * `far_frame_allocator_` numbers the far tier's frames from 0.
      * */
-    uint64_t* avail_frames_;
+    FrameAllocator* frame_allocator_;
+    FrameAllocator* far_frame_allocator_ =nullptr;
+
+    uint64_t next_migration_cycle_;
+    /*
+     * Cores that held a translation changed by this migration epoch, which
+     * take one (batched) TLB shootdown at its end.
+     * */
+    bool shootdown_cores_[N_THREADS] = {};
 public:
-    OS(uint64_t dram_size_mb);
+    OS(uint64_t dram_size_mb, const OSConfig&);
     ~OS(void);
 
-    uint64_t v2p(uint64_t lineaddr);
+    /*
+     * Runs the migration daemon (and `tiers_`) when tiering is enabled.
+     * */
+    void tick(void);
+    /*
+     * Makes a process for `trace_file` on core `coreid`. ASIDs are handed out
+     * in order from 0.
+     * */
+    void     add_process(std::string trace_file, size_t coreid);
+    /*
+     * Round-robin: returns the next process to run on `coreid`.
+     * */
+    Process* schedule(size_t coreid);
+
+    uint64_t v2p(uint64_t lineaddr, size_t coreid);
+    /*
+     * Exits if the line's frame is not mapped.
+     * */
     uint64_t p2v(uint64_t lineaddr);
+    /*
+     * Appends to `out` the mapped pages with lines in rows
+     * [row_first, row_last] of the given bank, row by row. Uses the native
+     * address mapping (`dram/address.h`).
+     * */
+    void pages_in_rows(size_t ch, size_t sc, size_t rank, size_t bg, size_t bank,
+                        uint64_t row_first, uint64_t row_last,
+                        std::vector<RowPage>& out) const;
+    /*
+     * Page walk for `vpn`, which is mapped if it is not mapped yet: sets
+     * `pte_lineaddr[lvl]` to the physical line address of the entry read at
+     * each level, from `PT_LEVELS-1` down to the returned level (0, or the
+     * level of a huge page).
+     * */
+    size_t get_walk(uint64_t vpn, uint64_t pte_lineaddr[PT_LEVELS]);
+#ifdef COMPRESSION_TRACES
+    /*
+     * Line contents by virtual line address; the page must be mapped.
+     * */
+    void read_line(uint64_t lineaddr, char data[LINESIZE]);
+    void write_line(uint64_t lineaddr, const char data[LINESIZE]);
+#endif
+    /*
+     * Counts a memory access to a physical line against its page.
+     * */
+    void note_memory_access(uint64_t lineaddr, bool is_read);
+    /*
+     * Called by `MemoryTiers` once the copy out of a moved page's old frame is
+     * done (see `move_page`).
+     * */
+    void free_moved_frame(uint64_t pfn);
 
     void print_stats(std::ostream&);
 private:
-    void map_page(OSPage&);
+    /*
+     * Walks the page table, and maps `vpn` if it is not mapped yet.
+     * */
+    uint64_t translate(uint64_t vpn);
+    /*
+     * Returns 0 if `vpn` is not mapped.
+     * */
+    uint64_t walk(uint64_t vpn) const;
+    /*
+     * Returns the entry for `vpn` at `level` (0 is the leaf level), creating
+     * any missing nodes on the way.
+     * */
+    uint64_t& pte(uint64_t vpn, size_t level =0);
+    uint64_t  new_pt_node(void);
+    /*
+     * Frees the frames mapped below `node` (at `level`) and its nodes.
+     * */
+    void      free_pt_subtree(uint64_t node, size_t level);
+
+    uint64_t map_page(uint64_t vpn);
+    /*
+     * Near tier first, then far tier. `alloc_frame` returns 0 if both are
+     * full.
+     * */
+    uint64_t alloc_frame(uint64_t vpn);
+    void     free_frame(uint64_t pfn);
+    uint64_t alloc_block(size_t order);
+    void     free_block(uint64_t pfn, size_t order);
+    /*
+     * Maps the huge page containing `vpn` if the region is still empty
+     * (ALWAYS), or replaces its base pages (PROMOTE). Returns false if there
+     * is no free huge frame.
+     * */
+    bool map_huge_page(uint64_t vpn);
+    bool promote_huge_page(uint64_t vpn);
+
+    void invalidate_tc(uint64_t first_vpn, uint64_t num_pages);
+    /*
+     * Huge mappings do not make an `OSPage` per base page: this makes it on
+     * first use.
+     * */
+    OSPage& get_page(uint64_t vpn);
+    /*
+     * The migration daemon (see `TierConfig`), and the move of one base page
+     * to `pfn`, which queues its copy in `tiers_`. The old frame is freed when
+     * the copy is done, unless `free_old` is false (the caller reuses it as
+     * the destination of the next copy). The page is dropped from every TLB
+     * that has it.
+     * */
+    void migrate_pages(void);
+    void move_page(uint64_t vpn, OSPage&, uint64_t pfn, bool free_old =true);
+    bool is_huge_mapped(uint64_t vpn);
 };
 
 ////////////////////////////////////////////////////////////////
@@ -0,0 +1,142 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#include "os/binned_allocator.h"
+#include "dram/address.h"
+
+#include <iostream>
+
+#include <stdlib.h>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+constexpr size_t LLC_SETS = (LLC_SIZE_KB*1024)/(LLC_ASSOC*LINESIZE);
+/*
+ * Bins are PFN bits, which needs the fields they come from to be bit
+ * selects.
+ * */
+constexpr bool COLOR_BITS_OK = FastDiv<LLC_SETS>::IS_POW2;
+constexpr bool BANK_BITS_OK = FastDiv<NUM_CHANNELS>::IS_POW2
+                                && FastDiv<NUM_SUBCHANNELS>::IS_POW2
+                                && FastDiv<NUM_RANKS>::IS_POW2
+                                && FastDiv<NUM_BANKGROUPS>::IS_POW2
+                                && FastDiv<NUM_BANKS>::IS_POW2;
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+BinnedFrameAllocator::BinnedFrameAllocator(uint64_t num_frames, BinOrder order)
+    :FrameAllocator(num_frames),
+    order_(order)
+{
+    if ((order_ == BinOrder::COLOR && !COLOR_BITS_OK)
+        || ((order_ == BinOrder::BANK_SPREAD || order_ == BinOrder::BANK_PACK) && !BANK_BITS_OK))
+    {
+        std::cerr << "BinnedFrameAllocator: page coloring and bank binning need a power-of-two"
+                    << " number of LLC sets and DRAM channels, ranks, and banks.\n";
+        exit(1);
+    }
+    // Frame 0 is never handed out, and `num_frames-1` must be nonzero below.
+    if (num_frames < 2) {
+        std::cerr << "BinnedFrameAllocator: need at least 2 frames, got " << num_frames << ".\n";
+        exit(1);
+    }
+    size_t frame_bits = 64 - __builtin_clzll(num_frames-1);
+    for (size_t i = 0; i < frame_bits; i++) {
+        bool is_bin_bit = false;
+        if (order_ == BinOrder::COLOR) {
+            is_bin_bit = i < Log2<LLC_SETS>::value - Log2<LINES_PER_PAGE>::value;
+        } else if (order_ == BinOrder::BANK_SPREAD || order_ == BinOrder::BANK_PACK) {
+            uint64_t x = (1ULL << i) << Log2<LINES_PER_PAGE>::value;
+            is_bin_bit = CHANNEL(x) | SUBCHANNEL(x) | RANK(x) | BANKGROUP(x) | BANK(x);
+        }
+
+        if (is_bin_bit) bin_bits_.push_back(i);
+        else            index_bits_.push_back(i);
+    }
+
+    size_t num_bins = 1L << bin_bits_.size();
+    next_index_.assign(num_bins, 0);
+    freed_.assign(num_bins, {});
+    next_index_[0] = 1;  // Skip frame 0.
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+uint64_t
+BinnedFrameAllocator::alloc(uint64_t vpn) {
+    const size_t num_bins = next_index_.size();
+
+    size_t bin = 0;
+    if (order_ == BinOrder::COLOR) {
+        bin = get_bin(vpn);
+    } else if (order_ == BinOrder::BANK_SPREAD || order_ == BinOrder::BANK_PACK) {
+        bin = next_bin_;
+    }
+
+    for (size_t i = 0; i < num_bins; i++) {
+        uint64_t pfn = alloc_from_bin(bin);
+        if (pfn != 0) {
+            if (order_ == BinOrder::BANK_SPREAD) {
+                next_bin_ = (bin+1) % num_bins;
+            } else if (order_ == BinOrder::BANK_PACK) {
+                next_bin_ = bin;
+            }
+            return pfn;
+        }
+        bin = (bin+1) % num_bins;
+    }
+    return 0;
+}
+
+void
+BinnedFrameAllocator::free(uint64_t pfn) {
+    freed_[get_bin(pfn)].push_back(pfn);
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+uint64_t
+BinnedFrameAllocator::alloc_from_bin(size_t bin) {
+    if (!freed_[bin].empty()) {
+        uint64_t pfn = freed_[bin].back();
+        freed_[bin].pop_back();
+        return pfn;
+    }
+
+    uint64_t ii = next_index_[bin];
+    if (ii >> index_bits_.size()) {
+        return 0;
+    }
+    // Scatter `bin` and `ii` into their bits of the PFN.
+    uint64_t pfn = 0;
+    for (size_t i = 0; i < bin_bits_.size(); i++) {
+        pfn |= ((bin >> i) & 1) << bin_bits_[i];
+    }
+    for (size_t i = 0; i < index_bits_.size(); i++) {
+        pfn |= ((ii >> i) & 1) << index_bits_[i];
+    }
+    // Frames of a bin increase with the index, so the bin is done.
+    if (pfn >= num_frames_) {
+        return 0;
+    }
+    ++next_index_[bin];
+    return pfn;
+}
+
+size_t
+BinnedFrameAllocator::get_bin(uint64_t x) const {
+    size_t bin = 0;
+    for (size_t i = 0; i < bin_bits_.size(); i++) {
+        bin |= ((x >> bin_bits_[i]) & 1) << i;
+    }
+    return bin;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
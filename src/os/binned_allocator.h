@@ -0,0 +1,68 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#ifndef OS_BINNED_ALLOCATOR_h
+#define OS_BINNED_ALLOCATOR_h
+
+#include "os/frame_allocator.h"
+
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * How `BinnedFrameAllocator` picks a bin for a new page:
+ *  SEQUENTIAL:     there is one bin.
+ *  COLOR:          bins are LLC set colors, and the bin is the color of the
+ *                  virtual page (classic OS page coloring).
+ *  BANK_SPREAD:    bins are banks, round-robin.
+ *  BANK_PACK:      bins are banks, the lowest bin with a free frame.
+ * If the chosen bin is full, the next bin with a free frame is used.
+ * */
+enum class BinOrder { SEQUENTIAL, COLOR, BANK_SPREAD, BANK_PACK };
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * Splits the frames into bins by a set of PFN bits (`bin_bits_`): for colors,
+ * the PFN bits of the LLC set index; for banks, the PFN bits that
+ * `CHANNEL`, `RANK`, `BANKGROUP` or `BANK` (see `dram/address.h`) depend on.
+ * Since those are bit selects, the i-th frame of bin b is found by scattering
+ * the bits of b into `bin_bits_` and the bits of i into the rest, so every bin
+ * is handed out lowest frame first with a cursor, in O(1). Freed frames are
+ * reused first. This needs the LLC set count (COLOR) or the DRAM geometry
+ * (BANK_*) to be powers of two.
+ *
+ * Bank placement follows the native DRAM model's address mapping. With
+ * DRAMsim3, the mapping comes from its *.ini file and may differ.
+ * */
+class BinnedFrameAllocator : public FrameAllocator {
+private:
+    const BinOrder order_;
+
+    std::vector<size_t> bin_bits_;
+    std::vector<size_t> index_bits_;
+    /*
+     * Per bin: the index of the next frame that was never handed out, and the
+     * frames that were freed.
+     * */
+    std::vector<uint64_t>               next_index_;
+    std::vector<std::vector<uint64_t>>  freed_;
+
+    size_t next_bin_ =0;
+public:
+    BinnedFrameAllocator(uint64_t num_frames, BinOrder);
+
+    uint64_t alloc(uint64_t vpn) override;
+    void     free(uint64_t pfn) override;
+private:
+    uint64_t alloc_from_bin(size_t bin);
+    size_t   get_bin(uint64_t pfn) const;
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+#endif  // OS_BINNED_ALLOCATOR_h
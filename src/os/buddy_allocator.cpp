@@ -0,0 +1,162 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#include "os/buddy_allocator.h"
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+FrameBitmap::FrameBitmap(uint64_t num_bits) {
+    uint64_t words;
+    do {
+        words = (num_bits+63) >> 6;
+        levels_.emplace_back(words, 0);
+        num_bits = words;
+    } while (words > 1);
+}
+
+void
+FrameBitmap::set(uint64_t ii) {
+    for (auto& lvl : levels_) {
+        uint64_t& w = lvl[ii >> 6];
+        bool was_empty = (w == 0);
+        w |= 1ULL << (ii & 63);
+        if (!was_empty) {
+            return;
+        }
+        ii >>= 6;
+    }
+}
+
+void
+FrameBitmap::clear(uint64_t ii) {
+    for (auto& lvl : levels_) {
+        uint64_t& w = lvl[ii >> 6];
+        w &= ~(1ULL << (ii & 63));
+        if (w != 0) {
+            return;
+        }
+        ii >>= 6;
+    }
+}
+
+bool
+FrameBitmap::test(uint64_t ii) const {
+    return (levels_[0][ii >> 6] >> (ii & 63)) & 1;
+}
+
+uint64_t
+FrameBitmap::find_first() const {
+    uint64_t ii = 0;
+    for (size_t k = levels_.size(); k > 0; k--) {
+        uint64_t w = levels_[k-1][ii];
+        if (w == 0) {
+            return NONE;
+        }
+        ii = (ii << 6) | __builtin_ctzll(w);
+    }
+    return ii;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+BuddyFrameAllocator::BuddyFrameAllocator(uint64_t num_frames)
+    :FrameAllocator(num_frames),
+    num_free_blocks_(BUDDY_MAX_ORDER+1, 0)
+{
+    for (size_t k = 0; k <= BUDDY_MAX_ORDER; k++) {
+        free_blocks_.emplace_back((num_frames >> k) + 1);
+    }
+    // Cover [1, num_frames) with the largest aligned blocks that fit.
+    uint64_t pfn = 1;
+    while (pfn < num_frames) {
+        size_t k = 0;
+        while (k < BUDDY_MAX_ORDER
+                && (pfn & ((2ULL << k)-1)) == 0
+                && pfn + (2ULL << k) <= num_frames)
+        {
+            ++k;
+        }
+        free_blocks_[k].set(pfn >> k);
+        ++num_free_blocks_[k];
+        pfn += 1ULL << k;
+    }
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+uint64_t
+BuddyFrameAllocator::alloc(uint64_t vpn) {
+    return alloc_block(0);
+}
+
+void
+BuddyFrameAllocator::free(uint64_t pfn) {
+    free_block(pfn, 0);
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+uint64_t
+BuddyFrameAllocator::alloc_block(size_t order) {
+    size_t k = order;
+    while (k <= BUDDY_MAX_ORDER && num_free_blocks_[k] == 0) {
+        ++k;
+    }
+    if (k > BUDDY_MAX_ORDER) {
+        return 0;
+    }
+    uint64_t b = free_blocks_[k].find_first();
+    free_blocks_[k].clear(b);
+    --num_free_blocks_[k];
+    // Keep the lower half, free the upper half.
+    while (k > order) {
+        --k;
+        b <<= 1;
+        free_blocks_[k].set(b+1);
+        ++num_free_blocks_[k];
+    }
+    return b << order;
+}
+
+void
+BuddyFrameAllocator::free_block(uint64_t pfn, size_t order) {
+    uint64_t b = pfn >> order;
+    size_t k = order;
+    while (k < BUDDY_MAX_ORDER && free_blocks_[k].test(b^1)) {
+        free_blocks_[k].clear(b^1);
+        --num_free_blocks_[k];
+        b >>= 1;
+        ++k;
+    }
+    free_blocks_[k].set(b);
+    ++num_free_blocks_[k];
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+BuddyFrameAllocator::print_stats(std::ostream& out) {
+    uint64_t free_frames = 0;
+    for (size_t k = 0; k <= BUDDY_MAX_ORDER; k++) {
+        free_frames += num_free_blocks_[k] << k;
+    }
+    PRINT_STAT(out, "OS_BUDDY_FREE_FRAMES", free_frames);
+    for (auto [ name, order ] : { std::make_pair("OS_BUDDY_FRAG_2MB", 9), std::make_pair("OS_BUDDY_FRAG_1GB", 18) }) {
+        uint64_t in_blocks = 0;
+        for (size_t k = order; k <= BUDDY_MAX_ORDER; k++) {
+            in_blocks += num_free_blocks_[k] << k;
+        }
+        double frag = free_frames ? 1.0 - ((double)in_blocks)/((double)free_frames) : 0.0;
+        PRINT_STAT(out, name, frag);
+    }
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
@@ -0,0 +1,69 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#ifndef OS_BUDDY_ALLOCATOR_h
+#define OS_BUDDY_ALLOCATOR_h
+
+#include "os/frame_allocator.h"
+
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * Bitmap with a summary level per 64x: bit i of level k+1 is set iff word i of
+ * level k is non-zero. `find_first` reads one word per level.
+ * */
+class FrameBitmap {
+public:
+    constexpr static uint64_t NONE = ~0ULL;
+private:
+    std::vector<std::vector<uint64_t>> levels_;
+public:
+    FrameBitmap(uint64_t num_bits);
+
+    void set(uint64_t);
+    void clear(uint64_t);
+    bool test(uint64_t) const;
+    /*
+     * Returns the lowest set bit, or `NONE`.
+     * */
+    uint64_t find_first(void) const;
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * Binary buddy allocator: free blocks of 2^order frames (up to
+ * `BUDDY_MAX_ORDER`, a 1 GB block) are kept in one `FrameBitmap` per order,
+ * indexed by `pfn >> order`. Allocation takes the lowest free block of the
+ * smallest order that has one, and splits it down; freeing merges a block with
+ * its buddy for as long as the buddy is free.
+ * */
+constexpr size_t BUDDY_MAX_ORDER = 18;
+
+class BuddyFrameAllocator : public FrameAllocator {
+private:
+    std::vector<FrameBitmap> free_blocks_;
+    std::vector<uint64_t>    num_free_blocks_;
+public:
+    BuddyFrameAllocator(uint64_t num_frames);
+
+    uint64_t alloc(uint64_t vpn) override;
+    void     free(uint64_t pfn) override;
+
+    uint64_t alloc_block(size_t order) override;
+    void     free_block(uint64_t pfn, size_t order) override;
+    /*
+     * Prints free frames and, for 2 MB and 1 GB blocks, the fragmentation:
+     * the fraction of free frames that are not in a free block that large.
+     * */
+    void print_stats(std::ostream&) override;
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+#endif  // OS_BUDDY_ALLOCATOR_h
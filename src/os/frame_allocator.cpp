@@ -0,0 +1,58 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#include "os/frame_allocator.h"
+#include "os/binned_allocator.h"
+#include "os/buddy_allocator.h"
+#include "os/random_allocator.h"
+
+#include <iostream>
+
+#include <stdlib.h>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+FrameAllocPolicy
+frame_alloc_policy_from_name(std::string name) {
+    for (FrameAllocPolicy p : { FrameAllocPolicy::RANDOM,
+                                FrameAllocPolicy::BUDDY,
+                                FrameAllocPolicy::SEQUENTIAL,
+                                FrameAllocPolicy::COLOR,
+                                FrameAllocPolicy::BANK_SPREAD,
+                                FrameAllocPolicy::BANK_PACK })
+    {
+        if (frame_alloc_policy_name(p) == name) {
+            return p;
+        }
+    }
+    std::cerr << "frame_alloc_policy_from_name: unknown frame allocation policy \"" << name << "\".\n";
+    exit(1);
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+FrameAllocator*
+make_frame_allocator(FrameAllocPolicy p, uint64_t num_frames) {
+    switch (p) {
+    case FrameAllocPolicy::RANDOM:
+        return new RandomFrameAllocator(num_frames);
+    case FrameAllocPolicy::BUDDY:
+        return new BuddyFrameAllocator(num_frames);
+    case FrameAllocPolicy::SEQUENTIAL:
+        return new BinnedFrameAllocator(num_frames, BinOrder::SEQUENTIAL);
+    case FrameAllocPolicy::COLOR:
+        return new BinnedFrameAllocator(num_frames, BinOrder::COLOR);
+    case FrameAllocPolicy::BANK_SPREAD:
+        return new BinnedFrameAllocator(num_frames, BinOrder::BANK_SPREAD);
+    case FrameAllocPolicy::BANK_PACK:
+        return new BinnedFrameAllocator(num_frames, BinOrder::BANK_PACK);
+    }
+    return nullptr;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
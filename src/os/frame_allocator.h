@@ -0,0 +1,90 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#ifndef OS_FRAME_ALLOCATOR_h
+#define OS_FRAME_ALLOCATOR_h
+
+#include "defs.h"
+
+#include <iostream>
+#include <string>
+#include <string_view>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+enum class FrameAllocPolicy { RANDOM, BUDDY, SEQUENTIAL, COLOR, BANK_SPREAD, BANK_PACK };
+
+inline std::string_view
+frame_alloc_policy_name(FrameAllocPolicy p) {
+    if (p == FrameAllocPolicy::RANDOM)      return "random";
+    if (p == FrameAllocPolicy::BUDDY)       return "buddy";
+    if (p == FrameAllocPolicy::SEQUENTIAL)  return "sequential";
+    if (p == FrameAllocPolicy::COLOR)       return "color";
+    if (p == FrameAllocPolicy::BANK_SPREAD) return "bank_spread";
+    if (p == FrameAllocPolicy::BANK_PACK)   return "bank_pack";
+    return "unknown";
+}
+
+/*
+ * Inverse of `frame_alloc_policy_name`. Exits on an unknown name.
+ * */
+FrameAllocPolicy frame_alloc_policy_from_name(std::string);
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * Physical frame allocation plug-in used by `OS::map_page`. Frames are
+ * numbered [0, num_frames); frame 0 is never handed out, so a PFN of 0 can
+ * mean "no frame" (see the page table in `os.h`).
+ *
+ *  `alloc`: returns a free frame for virtual page `vpn`, or 0 if all frames
+ *      are in use.
+ *  `free`: returns a frame obtained from `alloc`.
+ *  `alloc_block`: returns the first frame of 2^order contiguous free frames,
+ *      aligned to their size, or 0. Only `buddy` has blocks: the others
+ *      always return 0.
+ *  `free_block`: returns a block obtained from `alloc_block`.
+ *
+ * Policies (see `make_frame_allocator`):
+ *  random:         uniformly random free frame (`RandomFrameAllocator`).
+ *  buddy:          binary buddy allocator, lowest free block first
+ *                  (`BuddyFrameAllocator`).
+ *  sequential:     lowest frames first, freed frames are reused first.
+ *  color:          the frame has the same LLC set color as `vpn`.
+ *  bank_spread:    consecutive allocations go round-robin across banks.
+ *  bank_pack:      fill one bank before moving on to the next.
+ * The last four are `BinnedFrameAllocator`s.
+ * */
+class FrameAllocator {
+public:
+    const uint64_t num_frames_;
+
+    FrameAllocator(uint64_t num_frames)
+        :num_frames_(num_frames)
+    {}
+    virtual ~FrameAllocator(void) =default;
+
+    virtual uint64_t alloc(uint64_t vpn) =0;
+    virtual void     free(uint64_t pfn) =0;
+
+    virtual uint64_t alloc_block(size_t order) { return 0; }
+    virtual void     free_block(uint64_t pfn, size_t order) {}
+
+    virtual void print_stats(std::ostream&) {}
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * Builds the allocator for `p`. Randomized policies are seeded from `GL_RNG_`,
+ * so placement is reproducible from run to run.
+ * */
+FrameAllocator* make_frame_allocator(FrameAllocPolicy p, uint64_t num_frames);
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+#endif  // OS_FRAME_ALLOCATOR_h
@@ -0,0 +1,73 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#include "os/page_data.h"
+
+#include <string.h>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+static const char ZERO_PAGE[OS_PAGESIZE] {};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+const char*
+PageDataStore::get(uint32_t h) const {
+    return h == PAGE_DATA_ZERO ? ZERO_PAGE : slab(h);
+}
+
+char*
+PageDataStore::writable(uint32_t& h) {
+    if (h != PAGE_DATA_ZERO) {
+        return slab(h);
+    }
+    if (!free_slabs_.empty()) {
+        h = free_slabs_.back();
+        free_slabs_.pop_back();
+    } else {
+        if (num_slabs_ >= chunks_.size()*PAGE_DATA_SLABS_PER_CHUNK) {
+            // Not value-initialized: the chunk is only backed by memory as
+            // its slabs are handed out.
+            chunks_.emplace_back(new char[PAGE_DATA_SLABS_PER_CHUNK*OS_PAGESIZE]);
+        }
+        h = num_slabs_++;
+    }
+    ++s_slabs_in_use_;
+    char* data = slab(h);
+    memset(data, 0, OS_PAGESIZE);
+    return data;
+}
+
+void
+PageDataStore::release(uint32_t& h) {
+    if (h == PAGE_DATA_ZERO) {
+        return;
+    }
+    free_slabs_.push_back(h);
+    --s_slabs_in_use_;
+    h = PAGE_DATA_ZERO;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+PageDataStore::print_stats(std::ostream& out) {
+    PRINT_STAT(out, "OS_PAGE_DATA_SLABS", s_slabs_in_use_);
+    PRINT_STAT(out, "OS_PAGE_DATA_MB", (chunks_.size()*PAGE_DATA_SLABS_PER_CHUNK*OS_PAGESIZE) >> 20);
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+char*
+PageDataStore::slab(uint32_t h) const {
+    return chunks_[h / PAGE_DATA_SLABS_PER_CHUNK].get() + (h % PAGE_DATA_SLABS_PER_CHUNK)*OS_PAGESIZE;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
@@ -0,0 +1,63 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#ifndef OS_PAGE_DATA_h
+#define OS_PAGE_DATA_h
+
+#include "defs.h"
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * Contents of virtual pages (COMPRESSION_TRACES), in 4 KB slabs named by a
+ * 32-bit handle. Handle `PAGE_DATA_ZERO` is a shared, read-only all-zero
+ * page: every page starts there, and only gets a slab of its own on the
+ * first write that is not all zeros (see `writable`).
+ *
+ * Slabs are carved out of chunks of `PAGE_DATA_SLABS_PER_CHUNK`, which are
+ * allocated when the previous chunk is used up. Released slabs are reused
+ * first.
+ * */
+constexpr uint32_t PAGE_DATA_ZERO = 0;
+constexpr size_t   PAGE_DATA_SLABS_PER_CHUNK = 256;
+
+class PageDataStore {
+public:
+    uint64_t s_slabs_in_use_ =0;
+private:
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    std::vector<uint32_t> free_slabs_;
+    /*
+     * Slabs handed out so far from `chunks_` (slab 0 is never handed out,
+     * it stands for `PAGE_DATA_ZERO`).
+     * */
+    uint32_t num_slabs_ =1;
+public:
+    const char* get(uint32_t h) const;
+    /*
+     * Returns the slab for `h`, first giving `h` a zeroed slab of its own if
+     * it is `PAGE_DATA_ZERO`.
+     * */
+    char* writable(uint32_t& h);
+    /*
+     * Returns `h`'s slab to the store, and resets `h` to `PAGE_DATA_ZERO`.
+     * */
+    void  release(uint32_t& h);
+
+    void print_stats(std::ostream&);
+private:
+    char* slab(uint32_t h) const;
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+#endif  // OS_PAGE_DATA_h
@@ -0,0 +1,70 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#include "os/process.h"
+#include "utils/bitcount.h"
+
+#include <string.h>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+Process::Process(size_t asid, size_t coreid, std::string trace_file)
+    :asid_(asid),
+    coreid_(coreid),
+    trace_file_(trace_file),
+    trace_in_( gzopen(trace_file.c_str(), "r") )
+{
+    read_next_inst();
+}
+
+Process::~Process() {
+    gzclose(trace_in_);
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+Process::read_next_inst() {
+    if (gzeof(trace_in_)) {
+        gzclose(trace_in_);
+        // Reread trace file.
+        trace_in_ = gzopen(trace_file_.c_str(), "r");
+        trace_inst_num_ = 0;
+    }
+#ifdef COMPRESSION_TRACES
+    // If we already have WB data, just use that.
+    if (trace_wb_data_.valid) {
+        trace_wb_data_.valid = false;
+        next_inst_.vla = trace_wb_data_.vla;
+        next_inst_.is_wb = true;
+        memmove( next_inst_.linedata, trace_wb_data_.linedata, 64 );
+    } else {
+        gzread( trace_in_, &next_inst_.num, 8 );
+        gzseek( trace_in_, 1, SEEK_CUR);
+        gzread( trace_in_, &next_inst_.vla, 8 );
+
+        next_inst_.is_wb = false;
+
+        gzread( trace_in_, &trace_wb_data_.valid, 1 );
+        if (trace_wb_data_.valid) {
+            gzread( trace_in_, &trace_wb_data_.vla, 8 );
+            gzread( trace_in_, trace_wb_data_.linedata, 64 );
+        }
+
+    }
+    next_inst_.vla >>= Log2<LINESIZE>::value; // Note that the given addresses are virtual byte addresses,
+                                                  // not LINE addresses.
+#else
+    gzread( trace_in_, &next_inst_.num, 5 );
+    gzread( trace_in_, &next_inst_.is_wb, 1 );
+    gzread( trace_in_, &next_inst_.vla, 4);
+#endif
+    TAG_VA_WITH_ASID(next_inst_.vla, asid_);
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
@@ -0,0 +1,67 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#ifndef OS_PROCESS_h
+#define OS_PROCESS_h
+
+#include "defs.h"
+
+#include <string>
+
+#include <stdint.h>
+#include <zlib.h>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * A process runs one trace in its own address space: virtual addresses are
+ * tagged with its ASID (see `TAG_VA_WITH_ASID`), so it has its own page table
+ * root. Processes are pinned to a core, and the OS time-slices the processes
+ * of each core (see `OS::schedule`).
+ * */
+class Process {
+public:
+    const size_t asid_;
+    const size_t coreid_;
+    /*
+     * Position in the trace: the core handles `next_inst_` once this reaches
+     * `next_inst_.num`.
+     * */
+    uint64_t trace_inst_num_ =0;
+    struct {
+        uint64_t num;
+        uint64_t vla;  // virtual line address
+        bool is_wb;
+        char linedata[64];
+    } next_inst_ {};
+
+    uint64_t s_inst_ =0;
+    uint64_t s_slices_ =0;
+private:
+    std::string trace_file_;
+    gzFile trace_in_;
+    /*
+     * Traces package reads and writes together. However, we want to split them up
+     * in case either fails (need to spin on cache controller).
+     * */
+    struct {
+        bool valid=false;
+        uint64_t vla;
+        char linedata[64];
+    } trace_wb_data_;
+public:
+    /*
+     * Opens `trace_file` and reads the first instruction.
+     * */
+    Process(size_t asid, size_t coreid, std::string trace_file);
+    ~Process(void);
+
+    void read_next_inst(void);
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+#endif  // OS_PROCESS_h
@@ -0,0 +1,59 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#include "os/random_allocator.h"
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+RandomFrameAllocator::RandomFrameAllocator(uint64_t num_frames)
+    :FrameAllocator(num_frames),
+    num_free_(num_frames-1),
+    rng_(GL_RNG_())
+{}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+uint64_t
+RandomFrameAllocator::alloc(uint64_t vpn) {
+    if (num_free_ == 0) {
+        return 0;
+    }
+    uint64_t ii = rng_() % num_free_;
+    uint64_t pfn = get_slot(ii);
+
+    --num_free_;
+    set_slot(ii, get_slot(num_free_));
+    slots_.erase(num_free_);
+    return pfn;
+}
+
+void
+RandomFrameAllocator::free(uint64_t pfn) {
+    set_slot(num_free_, pfn);
+    ++num_free_;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+uint64_t
+RandomFrameAllocator::get_slot(uint64_t ii) const {
+    auto it = slots_.find(ii);
+    return (it == slots_.end()) ? ii+1 : it->second;
+}
+
+void
+RandomFrameAllocator::set_slot(uint64_t ii, uint64_t pfn) {
+    if (pfn == ii+1) {
+        slots_.erase(ii);
+    } else {
+        slots_[ii] = pfn;
+    }
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
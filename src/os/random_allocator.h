@@ -0,0 +1,44 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#ifndef OS_RANDOM_ALLOCATOR_h
+#define OS_RANDOM_ALLOCATOR_h
+
+#include "os/frame_allocator.h"
+
+#include <random>
+#include <unordered_map>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * Hands out a uniformly random free frame in O(1), however full memory is.
+ *
+ * This is a Fisher-Yates shuffle of the frames that is generated lazily:
+ * slots [0, num_free_) of a virtual array hold the free frames. `alloc` takes
+ * a random slot and moves the last free slot into it, and `free` appends.
+ * Slot i initially holds frame i+1 (frame 0 is never handed out), so only the
+ * slots that were overwritten are stored.
+ * */
+class RandomFrameAllocator : public FrameAllocator {
+private:
+    std::unordered_map<uint64_t, uint64_t> slots_;
+    uint64_t num_free_;
+
+    std::mt19937_64 rng_;
+public:
+    RandomFrameAllocator(uint64_t num_frames);
+
+    uint64_t alloc(uint64_t vpn) override;
+    void     free(uint64_t pfn) override;
+private:
+    uint64_t get_slot(uint64_t) const;
+    void     set_slot(uint64_t, uint64_t pfn);
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+#endif  // OS_RANDOM_ALLOCATOR_h
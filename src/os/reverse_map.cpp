@@ -0,0 +1,64 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#include "os/reverse_map.h"
+
+#include <algorithm>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+constexpr uint64_t RMAP_CHUNK_SIZE = 1ULL << RMAP_CHUNK_BITS;
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+ReverseMap::ReverseMap(uint64_t num_frames)
+    :num_frames_(num_frames),
+    chunks_( (num_frames + RMAP_CHUNK_SIZE-1) >> RMAP_CHUNK_BITS )
+{}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+uint64_t
+ReverseMap::get(uint64_t pfn) const {
+    if (pfn >= num_frames_) {
+        return NONE;
+    }
+    const auto& c = chunks_[pfn >> RMAP_CHUNK_BITS];
+    return c ? c[pfn & (RMAP_CHUNK_SIZE-1)] : NONE;
+}
+
+void
+ReverseMap::set(uint64_t pfn, uint64_t vpn, uint64_t n) {
+    for (uint64_t i = 0; i < n; i++) {
+        auto& c = chunks_[(pfn+i) >> RMAP_CHUNK_BITS];
+        if (!c) {
+            c.reset(new uint64_t[RMAP_CHUNK_SIZE]);
+            std::fill(c.get(), c.get()+RMAP_CHUNK_SIZE, NONE);
+            ++num_chunks_allocated_;
+        }
+        c[(pfn+i) & (RMAP_CHUNK_SIZE-1)] = vpn+i;
+    }
+}
+
+void
+ReverseMap::clear(uint64_t pfn, uint64_t n) {
+    for (uint64_t i = 0; i < n; i++) {
+        auto& c = chunks_[(pfn+i) >> RMAP_CHUNK_BITS];
+        if (c) {
+            c[(pfn+i) & (RMAP_CHUNK_SIZE-1)] = NONE;
+        }
+    }
+}
+
+uint64_t
+ReverseMap::size_in_bytes() const {
+    return num_chunks_allocated_*RMAP_CHUNK_SIZE*sizeof(uint64_t);
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
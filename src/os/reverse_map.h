@@ -0,0 +1,52 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#ifndef OS_REVERSE_MAP_h
+#define OS_REVERSE_MAP_h
+
+#include "defs.h"
+
+#include <memory>
+#include <vector>
+
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * PFN -> VPN index. It is a flat array split into chunks of
+ * 2^`RMAP_CHUNK_BITS` frames, and a chunk is only allocated once one of its
+ * frames is mapped. Huge pages have an entry per base frame.
+ * */
+constexpr size_t RMAP_CHUNK_BITS = 12;
+
+class ReverseMap {
+public:
+    constexpr static uint64_t NONE = ~0ULL;
+private:
+    const uint64_t num_frames_;
+
+    std::vector<std::unique_ptr<uint64_t[]>> chunks_;
+    uint64_t num_chunks_allocated_ =0;
+public:
+    ReverseMap(uint64_t num_frames);
+    /*
+     * Returns `NONE` if `pfn` is not mapped, or not a frame at all (past the
+     * end of memory).
+     * */
+    uint64_t get(uint64_t pfn) const;
+    /*
+     * Maps frames [pfn, pfn+n) to pages [vpn, vpn+n).
+     * */
+    void set(uint64_t pfn, uint64_t vpn, uint64_t n =1);
+    void clear(uint64_t pfn, uint64_t n =1);
+
+    uint64_t size_in_bytes(void) const;
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+#endif  // OS_REVERSE_MAP_h
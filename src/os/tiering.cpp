@@ -0,0 +1,132 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#include "os/tiering.h"
+#include "os.h"
+#include "utils/bitcount.h"
+
+#ifdef USE_DRAMSIM3
+#include "ds3/interface.h"
+#else
+#include "dram/controller.h"
+#endif
+
+#include <algorithm>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+MemoryTiers::MemoryTiers(const TierConfig& conf, uint64_t near_frames)
+    :near_frames_(near_frames),
+    conf_(conf),
+    link_cycles_per_line_( LINESIZE*CPU_FREQ_GHZ / conf.far_gbps )
+{}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+MemoryTiers::tick() {
+    if (link_queue_.size() == FAR_LINK_QUEUE_SIZE) {
+        ++s_link_full_cycles_;
+    }
+    while (!link_queue_.empty() && link_queue_.front().depart_cycle <= GL_cycle_) {
+        const FarRequest& r = link_queue_.front();
+        if (!GL_memory_controller_->make_request(r.lineaddr, r.is_read)) {
+            break;
+        }
+        link_queue_.pop_front();
+    }
+
+    if (!copy_queue_.empty()) {
+        const CopyLine& l = copy_queue_.front();
+        if (send(l.lineaddr, l.is_read)) {
+            if (l.is_read) {
+                copy_reads_in_flight_.insert(l.lineaddr);
+            }
+            uint64_t free_pfn = l.free_pfn;
+            copy_queue_.pop_front();
+            ++s_copy_lines_;
+            if (free_pfn != 0) {
+                GL_os_->free_moved_frame(free_pfn);
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+bool
+MemoryTiers::access(uint64_t lineaddr, bool is_read) {
+    if (!send(lineaddr, is_read)) {
+        return false;
+    }
+    GL_os_->note_memory_access(lineaddr, is_read);
+    return true;
+}
+
+void
+MemoryTiers::copy_page(uint64_t src_pfn, uint64_t dst_pfn, bool free_src) {
+    for (uint64_t i = 0; i < LINES_PER_PAGE; i++) {
+        copy_queue_.push_back({ join_page_and_offset(src_pfn, i), true, 0 });
+    }
+    for (uint64_t i = 0; i < LINES_PER_PAGE; i++) {
+        copy_queue_.push_back({ join_page_and_offset(dst_pfn, i), false, 0 });
+    }
+    if (free_src) {
+        copy_queue_.back().free_pfn = src_pfn;
+    }
+}
+
+bool
+MemoryTiers::finish_copy_read(uint64_t lineaddr) {
+    auto it = copy_reads_in_flight_.find(lineaddr);
+    if (it == copy_reads_in_flight_.end()) {
+        return false;
+    }
+    copy_reads_in_flight_.erase(it);
+    return true;
+}
+
+bool
+MemoryTiers::is_far(uint64_t lineaddr) const {
+    return (lineaddr >> Log2<LINES_PER_PAGE>::value) >= near_frames_;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+void
+MemoryTiers::print_stats(std::ostream& out) {
+    PRINT_STAT(out, "TIER_FAR_READS", s_far_reads_);
+    PRINT_STAT(out, "TIER_FAR_WRITES", s_far_writes_);
+    PRINT_STAT(out, "TIER_LINK_FULL_CYCLES", s_link_full_cycles_);
+    PRINT_STAT(out, "TIER_COPY_LINES", s_copy_lines_);
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+bool
+MemoryTiers::send(uint64_t lineaddr, bool is_read) {
+    if (!is_far(lineaddr)) {
+        return GL_memory_controller_->make_request(lineaddr, is_read);
+    }
+    if (link_queue_.size() == FAR_LINK_QUEUE_SIZE) {
+        return false;
+    }
+    // Lines leave the link in order, no faster than its bandwidth.
+    double depart = std::max(link_next_free_, (double)(GL_cycle_ + conf_.far_latency));
+    link_next_free_ = depart + link_cycles_per_line_;
+    link_queue_.push_back({ lineaddr, is_read, (uint64_t)depart });
+
+    if (is_read) ++s_far_reads_;
+    else         ++s_far_writes_;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
@@ -0,0 +1,125 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#ifndef OS_TIERING_h
+#define OS_TIERING_h
+
+#include "defs.h"
+
+#include <deque>
+#include <iostream>
+#include <unordered_set>
+
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * Tiered memory: the first `near_mb` of physical memory is the near tier,
+ * the rest is the far tier (a CXL-like expander). Both are backed by the same
+ * memory controller, but far accesses first cross a link that adds
+ * `far_latency` cycles and carries at most `far_gbps`. `near_mb == 0`
+ * disables tiering.
+ *
+ * Pages are mapped in the near tier until it is full. Every `migrate_epoch`
+ * cycles, the OS promotes far pages with at least `hot_threshold` memory
+ * accesses (see `OSPage`), up to `migrate_pages` of them, hottest first. If
+ * the near tier is full, its coldest page is demoted to make room, as long
+ * as it is colder than the page being promoted. The epoch ends with one TLB
+ * shootdown on each core whose TLBs held a moved page.
+ * */
+struct TierConfig {
+    uint64_t near_mb =0;
+    uint64_t far_latency =280;
+    double   far_gbps =32.0;
+
+    uint64_t migrate_epoch =1'000'000;
+    uint64_t migrate_pages =64;
+    uint64_t hot_threshold =8;
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+constexpr double CPU_FREQ_GHZ = 4.0;
+constexpr size_t FAR_LINK_QUEUE_SIZE = 64;
+/*
+ * Cycles a core loses to a TLB shootdown (taking the IPI and invalidating),
+ * about 1us at `CPU_FREQ_GHZ`.
+ * */
+constexpr uint64_t TLB_SHOOTDOWN_CYCLES = 4000;
+
+/*
+ * Front end of the memory controller for `TierConfig`. LLC misses and
+ * writebacks come in through `access`, which counts them against their page
+ * (`OS::note_memory_access`). Page copies are queued with `copy_page` and
+ * sent one line per cycle, so they compete with demand traffic for the
+ * memory controller and the far link. A copy is done once its last line has
+ * been sent: its source frame is then handed back to the OS
+ * (`OS::free_moved_frame`), unless it is the destination of a later copy.
+ * */
+class MemoryTiers {
+public:
+    const uint64_t near_frames_;
+
+    uint64_t s_far_reads_ =0;
+    uint64_t s_far_writes_ =0;
+    uint64_t s_link_full_cycles_ =0;
+    uint64_t s_copy_lines_ =0;
+private:
+    const TierConfig conf_;
+    const double link_cycles_per_line_;
+    /*
+     * Requests crossing the far link, each with the cycle it reaches the
+     * memory controller. `link_next_free_` is when the link can take the next
+     * line.
+     * */
+    struct FarRequest {
+        uint64_t lineaddr;
+        bool     is_read;
+        uint64_t depart_cycle;
+    };
+    std::deque<FarRequest> link_queue_;
+    double link_next_free_ =0.0;
+
+    /*
+     * `free_pfn` is the frame to free once the line is sent (0 for none).
+     * */
+    struct CopyLine {
+        uint64_t lineaddr;
+        bool     is_read;
+        uint64_t free_pfn;
+    };
+    std::deque<CopyLine> copy_queue_;
+    /*
+     * Lines of copy reads sent to memory and not yet done (a line can be in
+     * more than one copy).
+     * */
+    std::unordered_multiset<uint64_t> copy_reads_in_flight_;
+public:
+    MemoryTiers(const TierConfig&, uint64_t near_frames);
+
+    void tick(void);
+    /*
+     * Returns false if the request could not be made.
+     * */
+    bool access(uint64_t lineaddr, bool is_read);
+    void copy_page(uint64_t src_pfn, uint64_t dst_pfn, bool free_src =true);
+    /*
+     * Called by the memory controller when a read of `lineaddr` is done.
+     * Returns true if it was a copy read, which is not an LLC fill.
+     * */
+    bool finish_copy_read(uint64_t lineaddr);
+
+    bool is_far(uint64_t lineaddr) const;
+
+    void print_stats(std::ostream&);
+private:
+    bool send(uint64_t lineaddr, bool is_read);
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+#endif  // OS_TIERING_h
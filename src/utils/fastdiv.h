@@ -0,0 +1,71 @@
+/*
+ *  author: agent
+ *  date:   19 October 2026
+ * */
+
+#ifndef UTILS_FASTDIV_h
+#define UTILS_FASTDIV_h
+
+#include "defs.h"
+#include "utils/bitcount.h"
+
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+/*
+ * Division and modulo of 64-bit values by a constant `D`, which does not need
+ * to be a power of two. A power of two is a shift and a mask. Otherwise, the
+ * reciprocal is precomputed as in Granlund and Montgomery (1994), Figure 4.1
+ * (the unsigned case of libdivide): a multiply-high, a subtract, an add and
+ * two shifts, exact for every 64-bit dividend.
+ * */
+template <uint64_t D>
+struct FastDiv {
+    static_assert(D > 0 && D < (1ULL << 63), "FastDiv: divisor out of range");
+
+    constexpr static bool   IS_POW2 = (D & (D-1)) == 0;
+    /*
+     * ceil(log2(D)), and the reciprocal 2^64*(2^L - D)/D + 1 (the low 64 bits
+     * of ceil(2^(64+L)/D)).
+     * */
+    constexpr static size_t L = Log2<D>::value + (IS_POW2 ? 0 : 1);
+    constexpr static uint64_t MAGIC = IS_POW2 ? 0 :
+            static_cast<uint64_t>(((static_cast<unsigned __int128>(1) << 64) * ((1ULL << L) - D)) / D + 1);
+
+    constexpr static uint64_t
+    div(uint64_t x) {
+        if constexpr (IS_POW2) {
+            return x >> L;
+        } else {
+            uint64_t q = static_cast<uint64_t>((static_cast<unsigned __int128>(MAGIC) * x) >> 64);
+            return (((x - q) >> 1) + q) >> (L-1);
+        }
+    }
+
+    constexpr static uint64_t
+    mod(uint64_t x) {
+        if constexpr (IS_POW2) {
+            return x & (D-1);
+        } else {
+            return x - div(x)*D;
+        }
+    }
+    /*
+     * Both at once, for one multiply.
+     * */
+    constexpr static void
+    divmod(uint64_t x, uint64_t& q, uint64_t& r) {
+        q = div(x);
+        if constexpr (IS_POW2) {
+            r = x & (D-1);
+        } else {
+            r = x - q*D;
+        }
+    }
+};
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+
+#endif  // UTILS_FASTDIV_h